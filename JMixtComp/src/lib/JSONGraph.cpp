@@ -20,6 +20,8 @@
  *  Authors:    Vincent KUBICKI <vincent.kubicki@inria.fr>
  **/
 
+#include <atomic>
+
 #include "JSONGraph.h"
 
 namespace mixt {
@@ -30,10 +32,12 @@ JSONGraph::JSONGraph(const nlohmann::json& j) :
 
 void JSONGraph::set(const nlohmann::json& j) {
 	j_ = j;
+	blocks_.clear();
 }
 
 void JSONGraph::set(const std::string& s) {
 	j_ = nlohmann::json::parse(s);
+	blocks_.clear();
 }
 
 std::string JSONGraph::get() const {
@@ -41,46 +45,67 @@ std::string JSONGraph::get() const {
 }
 
 void JSONGraph::getSubGraph(const std::vector<std::string>& path, JSONGraph& j) const {
-	nlohmann::json l;
-	go_to(path, l);
-
-	j.set(l);
+	j.set(go_to(path));
+	j.blocks_ = blocks_; // only the pointers are copied, the blocks that are not referenced in the sub graph are ignored
 }
 
-bool JSONGraph::exist_payload(const std::vector<std::string>& path, const std::string& name) const {
-	nlohmann::json l;
-	go_to(path, l);
+const JSONBlock* JSONGraph::findBlock(const nlohmann::json& node) const {
+	if (!node.is_object() || node.size() != 1) {
+		return nullptr;
+	}
 
-	if (l[name].is_null()) {
-		return false;
+	nlohmann::json::const_iterator it = node.find("$block");
+	if (it == node.end() || !it->is_number_unsigned()) {
+		return nullptr;
 	}
 
-	return true;
+	std::map<Index, std::shared_ptr<const JSONBlock>>::const_iterator itBlock = blocks_.find(it->get<Index>());
+	return (itBlock == blocks_.end()) ? nullptr : itBlock->second.get();
 }
 
-void JSONGraph::go_to(const std::vector<std::string>& path, nlohmann::json& l) const {
-	go_to(path, 0, j_, l);
+Index JSONGraph::newBlockId() {
+	static std::atomic<Index> nextId(0);
+	return nextId++;
 }
 
-void JSONGraph::go_to(const std::vector<std::string>& path, Index currDepth, const nlohmann::json& currLevel, nlohmann::json& l) const {
-	if (currDepth == path.size()) {
-		l = currLevel;
-	} else {
-		const nlohmann::json& nextLevel = currLevel[path[currDepth]];
-		if (nextLevel.is_null()) { // if next level does not exist, create it
+bool JSONGraph::exist_payload(const std::vector<std::string>& path, const std::string& name) const {
+	return find(go_to(path), name) != nullptr;
+}
+
+const nlohmann::json& JSONGraph::go_to(const std::vector<std::string>& path) const {
+	const nlohmann::json* p_currLevel = &j_;
+
+	for (Index currDepth = 0; currDepth < path.size(); ++currDepth) {
+		p_currLevel = find(*p_currLevel, path[currDepth]);
+
+		if (p_currLevel == nullptr) {
 			std::string askedPath;
 			for (Index i = 0; i < currDepth + 1; ++i) {
 				askedPath += +"/" + path[i];
 			}
 			throw(askedPath + " path does not exist.");
 		}
+	}
+
+	return *p_currLevel;
+}
+
+const nlohmann::json* JSONGraph::find(const nlohmann::json& node, const std::string& name) {
+	if (!node.is_object()) {
+		return nullptr;
+	}
 
-		go_to(path, currDepth + 1, nextLevel, l);
+	nlohmann::json::const_iterator it = node.find(name);
+	if (it == node.end() || it->is_null()) {
+		return nullptr;
 	}
+
+	return &(*it);
 }
 
 void JSONGraph::addSubGraph(const std::vector<std::string>& path, const std::string& name, const JSONGraph& p) {
 	addSubGraph(path, 0, j_, name, p);
+	blocks_.insert(p.blocks_.begin(), p.blocks_.end());
 }
 
 void JSONGraph::addSubGraph(const std::vector<std::string>& path, Index currDepth, nlohmann::json& currLevel, const std::string& name, const JSONGraph& p) {
@@ -104,8 +129,7 @@ void JSONGraph::addSubGraph(const std::vector<std::string>& path, Index currDept
 }
 
 void JSONGraph::name_payload(const std::vector<std::string>& path, std::list<std::string>& l) const {
-	nlohmann::json j;
-	go_to(path, j);
+	const nlohmann::json& j = go_to(path);
 
 	for (nlohmann::json::const_iterator it = j.begin(); it != j.end(); ++it) {
 		l.push_back(it.key());
@@ -23,8 +23,12 @@
 #ifndef JSON_JSONGRAPH_H
 #define JSON_JSONGRAPH_H
 
+#include <algorithm>
 #include <iostream>
 #include <list>
+#include <map>
+#include <memory>
+#include <type_traits>
 #include "json.hpp"
 #include <IO/NamedAlgebra.h>
 #include <IO/IOFunctions.h>
@@ -34,9 +38,94 @@
 
 namespace mixt {
 
+/**
+ * Read-only view on a data column stored in a JSONGraph, used by the simple mixtures to parse their data without
+ * copying it (see DataColumn in IOFunctions.h). The cells can be strings, numbers, or null for a missing value. It is
+ * only valid as long as the JSONGraph it has been read from is not modified or destroyed.
+ */
+class JSONDataColumn {
+public:
+	JSONDataColumn() :
+			p_array_(nullptr) {
+	}
+
+	void set(const nlohmann::json& array) {
+		p_array_ = &array;
+	}
+
+	Index size() const {
+		return p_array_ ? p_array_->size() : 0;
+	}
+
+	CellType cellType(Index i) const {
+		const nlohmann::json& cell = (*p_array_)[i];
+		if (cell.is_string()) {
+			return stringCell_;
+		}
+		return cell.is_number() ? numberCell_ : missingCell_;
+	}
+
+	Real number(Index i) const {
+		return (*p_array_)[i].get<Real>();
+	}
+
+	const std::string& operator[](Index i) const {
+		return (*p_array_)[i].get_ref<const std::string&>();
+	}
+
+private:
+	const nlohmann::json* p_array_;
+};
+
+/** The array must only contain strings, numbers and null values. */
+inline void translateJSONToCPP(const nlohmann::json& in, JSONDataColumn& out) {
+	bool isValid = in.is_array();
+	for (nlohmann::json::const_iterator it = in.begin(), itE = in.end(); isValid && it != itE; ++it) {
+		isValid = it->is_string() || it->is_number() || it->is_null();
+	}
+
+	if (!isValid) {
+		throw(std::string("A data column must be an array of strings, numbers and null values."));
+	}
+
+	out.set(in);
+}
+
+class JSONGraph;
+
+template<>
+struct DataColumn<JSONGraph> {
+	typedef JSONDataColumn Type;
+};
+
+/** The const methods of JSONGraph only read the nlohmann::json tree, which supports concurrent reads. */
+template<>
+struct GraphConcurrentRead<JSONGraph> {
+	static const bool value = true;
+};
+
+/**
+ * Numeric data of a NamedVector or NamedMatrix payload, kept out of the json tree of a JSONGraph, see
+ * JSONGraph::setBlockSize. The values are stored in row major order, in a single array.
+ */
+struct JSONBlock {
+	/** Number of rows */
+	Index nrow_;
+
+	/** Number of columns, 0 for the data of a NamedVector */
+	Index ncol_;
+
+	/** Whether the values were integers, so that they are written as such */
+	bool isInteger_;
+
+	std::vector<Real> data_;
+};
+
 class JSONGraph {
 public:
-	JSONGraph() {};
+	JSONGraph() :
+			blockSize_(0) {
+	}
 
 	JSONGraph(const nlohmann::json& j);
 
@@ -46,8 +135,25 @@ public:
 
 	std::string get() const;
 
+	/**
+	 * The json tree. If setBlockSize has been called, the data of the large payloads are replaced by references to
+	 * blocks, use JSONWriter to write the complete document.
+	 */
 	const nlohmann::json& getJ() const {return j_;}
 
+	/**
+	 * Keep the data of the NamedVector and NamedMatrix payloads of at least minSize values out of the json tree. A
+	 * json array uses about three times the memory of the values, and the blocks can be written straight to disk by
+	 * JSONWriter. The "data" element of the payload is then an object {"$block": id}. 0, the default, disables the
+	 * blocks. This is meant for output graphs: get_payload can not read the data of a payload stored in a block.
+	 */
+	void setBlockSize(Index minSize) {
+		blockSize_ = minSize;
+	}
+
+	/** Block referenced by node, nullptr if node is not a reference to a block of this graph. */
+	const JSONBlock* findBlock(const nlohmann::json& node) const;
+
 	void getSubGraph(const std::vector<std::string>& path, JSONGraph& j) const;
 
 	/**
@@ -65,15 +171,14 @@ public:
 	 */
 	template<typename Type>
 	void get_payload(const std::vector<std::string>& path, const std::string& name, Type& p) const {
-		nlohmann::json l;
-		go_to(path, l);
+		const nlohmann::json* p_payload = find(go_to(path), name);
 
-		if (l[name].is_null()) {
+		if (p_payload == nullptr) {
 			std::string cPath;
 			completePath(path, name, cPath);
 			throw(cPath + " object does not exist.");
 		}
-		translateJSONToCPP(l[name], p);
+		translateJSONToCPP(*p_payload, p);
 	}
 
 	/**
@@ -91,14 +196,16 @@ public:
 	void name_payload(const std::vector<std::string>& path, std::list<std::string>& l) const;
 
 private:
-	void go_to(const std::vector<std::string>& path, nlohmann::json& l) const;
+	/** Node at the end of path, by reference, nothing is copied. Throws if the path does not exist. */
+	const nlohmann::json& go_to(const std::vector<std::string>& path) const;
 
-	void go_to(const std::vector<std::string>& path, Index currDepth, const nlohmann::json& currLevel, nlohmann::json&) const;
+	/** Child name of an object node, nullptr if it does not exist or is null. */
+	static const nlohmann::json* find(const nlohmann::json& node, const std::string& name);
 
 	template<typename Type>
 	void add_payload(const std::vector<std::string>& path, Index currDepth, nlohmann::json& currLevel, const std::string& name, const Type& p) {
 		if (currDepth == path.size()) { // currLevel is the right element in path, add the payload
-			translateCPPToJSON(p, currLevel[name]);
+			translatePayload(p, currLevel[name]);
 		} else {
 			nlohmann::json& nextLevel = currLevel[path[currDepth]];
 
@@ -116,9 +223,80 @@ private:
 		}
 	}
 
+	template<typename Type>
+	void translatePayload(const Type& p, nlohmann::json& out) {
+		translateCPPToJSON(p, out);
+	}
+
+	template<typename T>
+	void translatePayload(const NamedVector<T>& p, nlohmann::json& out) {
+		Index nrow = p.vec_.size();
+		if (!std::is_arithmetic<T>::value || blockSize_ == 0 || nrow < blockSize_) {
+			translateCPPToJSON(p, out);
+			return;
+		}
+
+		out["ctype"] = "Vector";
+		out["data"] = addBlock(p.vec_, nrow, 0);
+		out["dtype"] = names<T>::name;
+		out["rowNames"] = p.rowNames_;
+		out["nrow"] = nrow;
+	}
+
+	template<typename T>
+	void translatePayload(const NamedMatrix<T>& p, nlohmann::json& out) {
+		Index nrow = p.mat_.rows();
+		Index ncol = p.mat_.cols();
+		if (!std::is_arithmetic<T>::value || blockSize_ == 0 || nrow * ncol < blockSize_) {
+			translateCPPToJSON(p, out);
+			return;
+		}
+
+		out["colNames"] = p.colNames_;
+		out["ctype"] = "Matrix";
+		out["data"] = addBlock(p.mat_, nrow, ncol);
+		out["dtype"] = names<T>::name;
+		out["rowNames"] = p.rowNames_;
+		out["ncol"] = ncol;
+		out["nrow"] = nrow;
+	}
+
+	/** Copy the values of a Vector (ncol = 0) or a Matrix in a new block, and return the reference to it. */
+	template<typename Data>
+	nlohmann::json addBlock(const Data& data, Index nrow, Index ncol) {
+		std::shared_ptr<JSONBlock> block = std::make_shared<JSONBlock>();
+		block->nrow_ = nrow;
+		block->ncol_ = ncol;
+		block->isInteger_ = std::is_integral<typename Data::Scalar>::value;
+		block->data_.resize(data.size());
+
+		Index nColStored = std::max(ncol, Index(1));
+		for (Index i = 0; i < nrow; ++i) {
+			for (Index j = 0; j < nColStored; ++j) {
+				block->data_[i * nColStored + j] = data(i, j);
+			}
+		}
+
+		Index id = newBlockId();
+		blocks_[id] = block;
+
+		nlohmann::json ref;
+		ref["$block"] = id;
+		return ref;
+	}
+
+	/** Identifiers are unique across all the graphs, so that the blocks of a sub graph can be moved to another graph. */
+	static Index newBlockId();
+
 	void addSubGraph(const std::vector<std::string>& path, Index currDepth, nlohmann::json& currLevel, const std::string& name, const JSONGraph& p);
 
 	nlohmann::json j_;
+
+	/** Minimum number of values of the payloads stored in blocks, 0 if the blocks are disabled */
+	Index blockSize_;
+
+	/** Blocks referenced from j_, or from the sub graphs that have been added to it */
+	std::map<Index, std::shared_ptr<const JSONBlock>> blocks_;
 };
 
 }
@@ -0,0 +1,226 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include "JSONWriter.h"
+
+namespace mixt {
+
+JSONWriter::JSONWriter(std::ostream& o, bool indent) :
+		o_(o), indent_(indent), binarySize_(0), nBinary_(0) {
+}
+
+void JSONWriter::setBinary(Index minSize, const std::string& dir, const std::string& prefix) {
+	binarySize_ = minSize;
+	binaryDir_ = dir;
+	binaryPrefix_ = prefix;
+}
+
+void JSONWriter::write(const JSONGraph& g) {
+	o_.width(0); // a width is used as an indentation by the operator<< of nlohmann::json
+	writeNode(g, g.getJ(), 0);
+}
+
+void JSONWriter::writeNode(const JSONGraph& g, const nlohmann::json& node, Index depth) {
+	if (node.is_object()) {
+		if (node.empty()) {
+			o_ << "{}";
+			return;
+		}
+
+		o_ << '{';
+		for (nlohmann::json::const_iterator it = node.begin(), itE = node.end(); it != itE; ++it) {
+			if (it != node.begin()) {
+				o_ << ',';
+			}
+			newLine(depth + 1);
+			o_ << nlohmann::json(it.key()) << (indent_ ? ": " : ":"); // the key is escaped as a json string
+
+			const JSONBlock* block = g.findBlock(it.value());
+			if (block == nullptr) {
+				writeNode(g, it.value(), depth + 1);
+			} else {
+				writeBlock(g, *block, depth + 1);
+			}
+		}
+		newLine(depth);
+		o_ << '}';
+	} else if (node.is_array()) {
+		if (node.empty()) {
+			o_ << "[]";
+			return;
+		}
+
+		o_ << '[';
+		for (nlohmann::json::const_iterator it = node.begin(), itE = node.end(); it != itE; ++it) {
+			if (it != node.begin()) {
+				o_ << ',';
+			}
+			newLine(depth + 1);
+			writeNode(g, *it, depth + 1);
+		}
+		newLine(depth);
+		o_ << ']';
+	} else {
+		o_ << node;
+	}
+}
+
+void JSONWriter::writeBlock(const JSONGraph& g, const JSONBlock& block, Index depth) {
+	if (0 < binarySize_ && binarySize_ <= block.data_.size()) {
+		writeNode(g, writeBinaryBlock(block), depth);
+		return;
+	}
+
+	if (block.ncol_ == 0) { // Vector
+		writeArray(block.data_.data(), block.nrow_, block.isInteger_, depth);
+		return;
+	}
+
+	if (block.nrow_ == 0) {
+		o_ << "[]";
+		return;
+	}
+
+	o_ << '[';
+	for (Index i = 0; i < block.nrow_; ++i) {
+		if (0 < i) {
+			o_ << ',';
+		}
+		newLine(depth + 1);
+		writeArray(block.data_.data() + i * block.ncol_, block.ncol_, block.isInteger_, depth + 1);
+	}
+	newLine(depth);
+	o_ << ']';
+}
+
+nlohmann::json JSONWriter::writeBinaryBlock(const JSONBlock& block) {
+	std::string fileName = binaryPrefix_ + "." + std::to_string(nBinary_) + ".bin";
+	++nBinary_;
+
+	std::ofstream file(binaryDir_ + fileName, std::ios::binary);
+	if (block.isInteger_) {
+		std::vector<std::int64_t> data(block.data_.begin(), block.data_.end());
+		file.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(std::int64_t));
+	} else {
+		file.write(reinterpret_cast<const char*>(block.data_.data()), block.data_.size() * sizeof(Real));
+	}
+
+	if (!file.good()) {
+		throw("Could not write the binary file " + binaryDir_ + fileName + ".");
+	}
+
+	nlohmann::json ref;
+	ref["dtype"] = block.isInteger_ ? "int64" : "float64";
+	ref["file"] = fileName;
+	ref["order"] = "row";
+	return ref;
+}
+
+void JSONWriter::writeArray(const Real* data, Index size, bool isInteger, Index depth) {
+	if (size == 0) {
+		o_ << "[]";
+		return;
+	}
+
+	o_ << '[';
+	for (Index i = 0; i < size; ++i) {
+		if (0 < i) {
+			o_ << ',';
+		}
+		newLine(depth + 1);
+		if (isInteger) {
+			o_ << nlohmann::json(std::int64_t(data[i]));
+		} else {
+			o_ << nlohmann::json(data[i]); // same format as nlohmann::json::dump, non finite values are written as null
+		}
+	}
+	newLine(depth);
+	o_ << ']';
+}
+
+void JSONWriter::newLine(Index depth) {
+	if (indent_) {
+		o_ << '\n' << std::string(4 * depth, ' ');
+	}
+}
+
+namespace {
+
+template<typename Type>
+nlohmann::json readBinaryArray(std::ifstream& file, Index size) {
+	std::vector<Type> data(size);
+	file.read(reinterpret_cast<char*>(data.data()), size * sizeof(Type));
+	return nlohmann::json(data);
+}
+
+void readBinaryBlock(nlohmann::json& node, const std::string& dir) {
+	const nlohmann::json& ref = node["data"];
+	std::string path = dir + ref["file"].get<std::string>();
+	std::string dtype = ref["dtype"].get<std::string>();
+
+	bool isMatrix = node.value("ctype", "") == "Matrix";
+	Index nrow = node.at("nrow").get<Index>();
+	Index ncol = isMatrix ? node.at("ncol").get<Index>() : 1;
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file.good()) {
+		throw("Could not read the binary file " + path + ".");
+	}
+
+	nlohmann::json data = nlohmann::json::array();
+	if (isMatrix) {
+		for (Index i = 0; i < nrow; ++i) {
+			data.push_back((dtype == "int64") ? readBinaryArray<std::int64_t>(file, ncol) : readBinaryArray<Real>(file, ncol));
+		}
+	} else {
+		data = (dtype == "int64") ? readBinaryArray<std::int64_t>(file, nrow) : readBinaryArray<Real>(file, nrow);
+	}
+
+	if (!file.good()) {
+		throw("The binary file " + path + " contains less than the " + std::to_string(nrow * ncol) + " expected values.");
+	}
+
+	node["data"] = std::move(data);
+}
+
+}
+
+void readBinaryData(nlohmann::json& j, const std::string& dir) {
+	if (!j.is_object()) {
+		return; // the references are only found in objects, the arrays do not need to be scanned
+	}
+
+	nlohmann::json::iterator itData = j.find("data");
+	if (itData != j.end() && itData->is_object() && itData->size() == 3 && itData->contains("file") && itData->contains("dtype") && itData->contains("order")) {
+		readBinaryBlock(j, dir);
+		return;
+	}
+
+	for (nlohmann::json::iterator it = j.begin(), itE = j.end(); it != itE; ++it) {
+		readBinaryData(*it, dir);
+	}
+}
+
+std::string fileDirectory(const std::string& path) {
+	std::string::size_type pos = path.find_last_of("/\\");
+	return (pos == std::string::npos) ? std::string() : path.substr(0, pos + 1);
+}
+
+} // namespace mixt
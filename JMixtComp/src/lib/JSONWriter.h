@@ -0,0 +1,97 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+#ifndef JSON_JSONWRITER_H
+#define JSON_JSONWRITER_H
+
+#include <iostream>
+#include <string>
+#include "json.hpp"
+#include "JSONGraph.h"
+
+namespace mixt {
+
+/**
+ * Serialization of a JSONGraph to a stream, node by node, without building the complete document in a string. The data
+ * of the blocks of the graph (see JSONGraph::setBlockSize) is written where it is referenced, either as json arrays or,
+ * for the largest ones, as binary side files.
+ *
+ * A block written in a side file is referenced by replacing its "data" array with:
+ * {"file": "<name of the side file>", "dtype": "float64" or "int64", "order": "row"}
+ * The side file contains the nrow x ncol values (nrow for a Vector) in row major order, in the byte order of the
+ * machine. The name is relative to the directory of the json file. readBinaryData replaces the references by the
+ * arrays.
+ */
+class JSONWriter {
+public:
+	/**
+	 * @param o output stream
+	 * @param indent pretty print with an indentation of 4 spaces, as nlohmann::json::dump(4), otherwise the output is
+	 * compact
+	 */
+	JSONWriter(std::ostream& o, bool indent);
+
+	/**
+	 * Write the blocks of at least minSize values in binary side files.
+	 *
+	 * @param minSize minimum number of values, 0 to write every block in the json stream (the default)
+	 * @param dir directory of the json file, where the side files are created
+	 * @param prefix prefix of the names of the side files, the k-th file is named prefix + ".k.bin"
+	 */
+	void setBinary(Index minSize, const std::string& dir, const std::string& prefix);
+
+	void write(const JSONGraph& g);
+
+private:
+	void writeNode(const JSONGraph& g, const nlohmann::json& node, Index depth);
+
+	void writeBlock(const JSONGraph& g, const JSONBlock& block, Index depth);
+
+	/** Write the block in a new side file, and return the reference to it. */
+	nlohmann::json writeBinaryBlock(const JSONBlock& block);
+
+	void writeArray(const Real* data, Index size, bool isInteger, Index depth);
+
+	void newLine(Index depth);
+
+	std::ostream& o_;
+
+	bool indent_;
+
+	Index binarySize_;
+
+	std::string binaryDir_;
+
+	std::string binaryPrefix_;
+
+	/** Number of side files written */
+	Index nBinary_;
+};
+
+/**
+ * Replace the references to binary side files written by JSONWriter with the corresponding json arrays.
+ *
+ * @param[in,out] j json document
+ * @param dir directory of the json file, the names of the side files are relative to it
+ */
+void readBinaryData(nlohmann::json& j, const std::string& dir);
+
+/** Directory part of a file path, with its trailing separator, empty for a file in the current directory. */
+std::string fileDirectory(const std::string& path);
+
+} // namespace mixt
+
+#endif /* JSON_JSONWRITER_H */
@@ -20,18 +20,23 @@
  *  Author:     Vincent KUBICKI <vincent.kubicki@inria.fr>
  **/
 
-#include <iomanip>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include "json.hpp"
 
 #include <Run/Learn.h>
+#include <Run/LearnSweep.h>
 #include <Run/Predict.h>
 #include <Various/Constants.h>
 #include "JSONGraph.h"
+#include "JSONWriter.h"
 
 using namespace mixt;
 
+/** Minimum number of values of the vectors and matrices kept out of the json tree of the results, see JSONGraph::setBlockSize */
+const Index resBlockSize = 1000;
+
 int main(int argc, char* argv[]) {
 	try {
 		std::cout << "JMixtComp" << std::endl;
@@ -70,12 +75,26 @@ int main(int argc, char* argv[]) {
 
 			std::string mode = algoG.get_payload<std::string>( { }, "mode");
 
+			bool outputIndent = false; // compact output by default
+			if (algoG.exist_payload( { }, "outputIndent")) {
+				outputIndent = algoG.get_payload<bool>( { }, "outputIndent");
+			}
+
+			Index outputBinarySize = 0; // no binary side files by default
+			if (algoG.exist_payload( { }, "outputBinarySize")) {
+				outputBinarySize = algoG.get_payload<Index>( { }, "outputBinarySize");
+			}
+
 			JSONGraph resG;
+			resG.setBlockSize((0 < outputBinarySize) ? std::min(resBlockSize, outputBinarySize) : resBlockSize);
 			std::string resFile;
 
 			if (mode == "learn") {
 				resFile = resLearnFile;
 				learn(algoG, dataG, descG, resG);
+			} else if (mode == "learnSweep") {
+				resFile = resLearnFile;
+				learnSweep(algoG, dataG, descG, resG);
 			} else if (mode == "predict") {
 				if (argc != 6) {
 					std::cout << "JMixtComp should be called with 5 parameters (paths to algo, data, model, resLearn, resPredict) in predict mode. It has been called with " << argc - 1 << " parameters."
@@ -94,6 +113,7 @@ int main(int argc, char* argv[]) {
 					resLearnStream >> resLearnJSON;
 
 					try {
+						readBinaryData(resLearnJSON, fileDirectory(resLearnFile));
 						JSONGraph paramG(resLearnJSON["variable"]["param"]);
 						predict(algoG, dataG, descG, paramG, resG);
 					} catch (const std::string& s) {
@@ -103,15 +123,19 @@ int main(int argc, char* argv[]) {
 
 
 			} else {
-				warnLog += "mode :" + mode + " not recognized. Please choose learn or predict." + eol;
+				warnLog += "mode :" + mode + " not recognized. Please choose learn, learnSweep or predict." + eol;
 			}
 
 			if (warnLog.size() > 0) {
 				resG.add_payload( { }, "warnLog", warnLog);
 			}
 
+			std::string resDir = fileDirectory(resFile);
 			std::ofstream o(resFile);
-			o << std::setw(4) << resG.getJ() << std::endl;
+			JSONWriter writer(o, outputIndent);
+			writer.setBinary(outputBinarySize, resDir, resFile.substr(resDir.size()));
+			writer.write(resG);
+			o << std::endl;
 		}
 	} catch (const std::string& s) {
 		std::cout << s << std::endl;
@@ -40,11 +40,16 @@ void translateCPPToJSON(const InType& in, nlohmann::json& out) {
 template<typename T>
 void translateCPPToJSON(const NamedVector<T>& in, nlohmann::json& out) {
 	Index nrow = in.vec_.size();
-	const T* rawData = in.vec_.data();
-	std::vector<T> data(rawData, rawData + in.vec_.size());
+
+	nlohmann::json data = nlohmann::json::array();
+	nlohmann::json::array_t& dataArray = data.get_ref<nlohmann::json::array_t&>();
+	dataArray.reserve(nrow);
+	for (Index i = 0; i < nrow; ++i) {
+		dataArray.emplace_back(in.vec_(i));
+	}
 
 	out["ctype"] = "Vector";
-	out["data"] = data;
+	out["data"] = std::move(data);
 	out["dtype"] = names<T>::name;
 	out["rowNames"] = in.rowNames_;
 	out["nrow"] = nrow;
@@ -54,17 +59,23 @@ template<typename T>
 void translateCPPToJSON(const NamedMatrix<T>& in, nlohmann::json& out) {
 	Index nrow = in.mat_.rows();
 	Index ncol = in.mat_.cols();
-	std::vector<std::vector<T>> data(nrow, std::vector<T>(ncol));
 
+	nlohmann::json data = nlohmann::json::array(); // filled in place, without an intermediate std::vector<std::vector<T>>
+	nlohmann::json::array_t& dataArray = data.get_ref<nlohmann::json::array_t&>();
+	dataArray.reserve(nrow);
 	for (Index i = 0; i < nrow; ++i) {
+		nlohmann::json row = nlohmann::json::array();
+		nlohmann::json::array_t& rowArray = row.get_ref<nlohmann::json::array_t&>();
+		rowArray.reserve(ncol);
 		for (Index j = 0; j < ncol; ++j) {
-			data[i][j] = in.mat_(i, j);
+			rowArray.emplace_back(in.mat_(i, j));
 		}
+		dataArray.emplace_back(std::move(row));
 	}
 
 	out["colNames"] = in.colNames_;
 	out["ctype"] = "Matrix";
-	out["data"] = data;
+	out["data"] = std::move(data);
 	out["dtype"] = names<T>::name;
 	out["rowNames"] = in.rowNames_;
 	out["ncol"] = ncol;
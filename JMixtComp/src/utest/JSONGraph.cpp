@@ -23,6 +23,7 @@
 #include "gtest/gtest.h"
 #include "MixtComp.h"
 #include "jsonIO.h"
+#include "JSONWriter.h"
 
 using namespace mixt;
 
@@ -115,6 +116,36 @@ TEST(JSONSGraph, VectorOfString) {
 	ASSERT_EQ(exp, comp);
 }
 
+TEST(JSONSGraph, DataColumn) {
+	std::string exp = R"-({"var":{"var1":["12.0","-35.90","205.72"],"var2":[1.5,null,"[1:2]",3],"var4":[1,true]}})-";
+	JSONGraph gIn;
+	gIn.set(exp);
+
+	DataColumn<JSONGraph>::Type col;
+	gIn.get_payload( { "var" }, "var1", col);
+
+	ASSERT_EQ(col.size(), 3);
+	ASSERT_EQ(col.cellType(1), stringCell_);
+	ASSERT_EQ(col[1], std::string("-35.90"));
+
+	gIn.get_payload( { "var" }, "var2", col);
+
+	ASSERT_EQ(col.size(), 4);
+	ASSERT_EQ(col.cellType(0), numberCell_);
+	ASSERT_EQ(col.number(0), 1.5);
+	ASSERT_EQ(col.cellType(1), missingCell_);
+	ASSERT_EQ(col.cellType(2), stringCell_);
+	ASSERT_EQ(col[2], std::string("[1:2]"));
+	ASSERT_EQ(col.number(3), 3.);
+
+	ASSERT_ANY_THROW(gIn.get_payload( { "var" }, "var4", col));
+	ASSERT_ANY_THROW(gIn.get_payload( { "var" }, "var3", col));
+	ASSERT_ANY_THROW(gIn.get_payload( { "missing" }, "var1", col));
+
+	ASSERT_TRUE(gIn.exist_payload( { "var" }, "var1"));
+	ASSERT_FALSE(gIn.exist_payload( { "var" }, "var3"));
+}
+
 TEST(JSONSGraph, name_payload) {
 	std::string exp = R"-({"var1":"12.0","varZ":"test"})-";
 	JSONGraph gIn;
@@ -159,3 +190,100 @@ TEST(JSONSGraph, AddSubGraph) {
 
 	ASSERT_EQ(gIn.get(), expected);
 }
+
+namespace {
+
+/** Graph with payloads large enough to be stored in blocks with a block size of 4, and small ones. */
+void fillWriterGraph(JSONGraph& g) {
+	std::vector<std::string> rowNames = {"a", "b"};
+	std::vector<std::string> colNames = {"x", "y", "z"};
+	Matrix<Real> mat(2, 3);
+	mat << 1.0, 2.5, -3.0, 4.0, std::numeric_limits<Real>::quiet_NaN(), 6.0;
+	Vector<Index> vec(5);
+	vec << 0, 1, 2, 3, 4;
+	Vector<Real> small(2);
+	small << 0.5, 1.5;
+
+	g.add_payload( { "variable", "param", "z_class" }, "stat", NamedMatrix<Real>( { rowNames, colNames, mat }));
+	g.add_payload( { "variable", "param", "z_class" }, "log", NamedVector<Index>( { std::vector<std::string>(), vec }));
+	g.add_payload( { "variable", "param", "z_class" }, "small", NamedVector<Real>( { std::vector<std::string>(), small }));
+	g.add_payload( { "mixture" }, "name \"quoted\"", "value");
+	g.add_payload( { "mixture" }, "empty", std::vector<Real>());
+}
+
+}
+
+TEST(JSONWriter, compactAndIndent) {
+	JSONGraph gExp;
+	fillWriterGraph(gExp);
+
+	JSONGraph g;
+	g.setBlockSize(4);
+	fillWriterGraph(g);
+	ASSERT_TRUE(g.findBlock(g.getJ()["variable"]["param"]["z_class"]["stat"]["data"]) != nullptr);
+	ASSERT_TRUE(g.findBlock(g.getJ()["variable"]["param"]["z_class"]["small"]["data"]) == nullptr);
+
+	std::ostringstream compact;
+	JSONWriter(compact, false).write(g);
+	ASSERT_EQ(compact.str(), gExp.getJ().dump());
+
+	std::ostringstream indent;
+	JSONWriter(indent, true).write(g);
+	ASSERT_EQ(indent.str(), gExp.getJ().dump(4));
+}
+
+TEST(JSONWriter, subGraphBlocks) {
+	JSONGraph gExp;
+	fillWriterGraph(gExp);
+
+	JSONGraph g;
+	g.setBlockSize(4);
+	fillWriterGraph(g);
+
+	JSONGraph sub;
+	g.getSubGraph( { "variable", "param" }, sub);
+	JSONGraph out;
+	out.addSubGraph( { "res" }, "param", sub);
+
+	std::ostringstream comp;
+	JSONWriter(comp, false).write(out);
+
+	nlohmann::json exp;
+	exp["res"]["param"] = gExp.getJ()["variable"]["param"];
+	ASSERT_EQ(comp.str(), exp.dump());
+}
+
+TEST(JSONWriter, binary) {
+	JSONGraph gExp;
+	fillWriterGraph(gExp);
+
+	JSONGraph g;
+	g.setBlockSize(4);
+	fillWriterGraph(g);
+
+	std::ostringstream comp;
+	JSONWriter writer(comp, false);
+	writer.setBinary(4, "", "UTestJSONWriter");
+	writer.write(g);
+
+	nlohmann::json j = nlohmann::json::parse(comp.str());
+	const nlohmann::json& ref = j["variable"]["param"]["z_class"]["stat"]["data"];
+	ASSERT_EQ(ref["dtype"], "float64");
+	ASSERT_EQ(j["variable"]["param"]["z_class"]["log"]["data"]["dtype"], "int64");
+	ASSERT_TRUE(j["variable"]["param"]["z_class"]["small"]["data"].is_array());
+
+	readBinaryData(j, "");
+	std::remove("UTestJSONWriter.0.bin");
+	std::remove("UTestJSONWriter.1.bin");
+
+	Real nan = j["variable"]["param"]["z_class"]["stat"]["data"][1][1];
+	ASSERT_TRUE(std::isnan(nan)); // the binary file keeps the non finite values, the json text writes them as null
+	j["variable"]["param"]["z_class"]["stat"]["data"][1][1] = nullptr;
+	ASSERT_EQ(j.dump(), gExp.getJ().dump());
+}
+
+TEST(JSONWriter, fileDirectory) {
+	ASSERT_EQ(fileDirectory("res.json"), "");
+	ASSERT_EQ(fileDirectory("out/res.json"), "out/");
+	ASSERT_EQ(fileDirectory("/tmp/out/res.json"), "/tmp/out/");
+}
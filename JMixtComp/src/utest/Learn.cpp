@@ -0,0 +1,145 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+/*
+ *  Project:    MixtComp
+ *  Created on: October 18, 2026
+ **/
+
+#include <map>
+
+#include "gtest/gtest.h"
+#include "MixtComp.h"
+#include "jsonIO.h"
+
+using namespace mixt;
+
+namespace {
+
+/** Small run on a Gaussian variable with two well separated classes, so that every run converges to the same estimate. */
+void learnInput(JSONGraph& algo, JSONGraph& data, JSONGraph& desc) {
+	Index nInd = 200;
+
+	nlohmann::json a;
+	a["nClass"] = 2;
+	a["nInd"] = nInd;
+	a["nbBurnInIter"] = 100;
+	a["nbIter"] = 50;
+	a["nbGibbsBurnInIter"] = 20;
+	a["nbGibbsIter"] = 20;
+	a["nInitPerClass"] = 10;
+	a["nSemTry"] = 5;
+	a["confidenceLevel"] = 0.95;
+	a["ratioStableCriterion"] = 0.99;
+	a["nStableCriterion"] = 20;
+	algo.set(a);
+
+	std::vector<std::string> gaussian(nInd);
+	for (Index i = 0; i < nInd; ++i) {
+		gaussian[i] = std::to_string(10. * (i % 2) + Real((i * 37) % 11) / 10.);
+	}
+	gaussian[3] = "?";
+
+	nlohmann::json d;
+	d["Gaussian1"] = gaussian;
+	data.set(d);
+
+	nlohmann::json m;
+	m["Gaussian1"] = { { "type", "Gaussian" }, { "paramStr", "" } };
+	desc.set(m);
+}
+
+}
+
+TEST(Learn, semChainSelection) {
+	Index nSemChain = 3;
+
+	JSONGraph algo, data, desc, out;
+	learnInput(algo, data, desc);
+	algo.add_payload( { }, "nSemChain", nSemChain);
+
+	learn(algo, data, desc, out);
+
+	ASSERT_FALSE(out.exist_payload( { }, "warnLog"));
+	ASSERT_EQ(out.get_payload<Index>( { "mixture", "semChain" }, "nChain"), nSemChain);
+
+	Vector<Real> lnCompLik;
+	std::vector<std::string> rowNames;
+	NamedVector<Real> lnCompLikNamed = { rowNames, lnCompLik };
+	out.get_payload( { "mixture", "semChain" }, "lnCompletedLikelihood", lnCompLikNamed);
+	ASSERT_EQ(lnCompLikNamed.vec_.size(), nSemChain);
+
+	Index selected = out.get_payload<Index>( { "mixture", "semChain" }, "selected");
+	ASSERT_LT(selected, nSemChain);
+	for (Index c = 0; c < nSemChain; ++c) { // the best chain is selected
+		ASSERT_LE(lnCompLikNamed.vec_(c), lnCompLikNamed.vec_(selected));
+	}
+}
+
+TEST(Learn, invalidSemChain) {
+	JSONGraph algo, data, desc, out;
+	learnInput(algo, data, desc);
+	algo.add_payload( { }, "nSemChain", -2);
+
+	learn(algo, data, desc, out);
+
+	ASSERT_TRUE(out.exist_payload( { }, "warnLog"));
+	ASSERT_FALSE(out.exist_payload( { }, "mixture"));
+}
+
+TEST(Learn, learnSweep) {
+	std::vector<Index> vecNClass = { 2, 1 };
+	Index nFit = vecNClass.size();
+
+	JSONGraph algo, data, desc, out;
+	learnInput(algo, data, desc);
+	algo.add_payload( { }, "nClass", vecNClass);
+
+	learnSweep(algo, data, desc, out);
+
+	std::vector<std::string> dummyNames;
+	std::vector<std::string> warnLogFit = out.get_payload<std::vector<std::string>>( { "summary" }, "warnLog");
+	std::vector<Index> nbFreeParameters = out.get_payload<std::vector<Index>>( { "summary" }, "nbFreeParameters");
+	std::map<std::string, NamedVector<Real>> summary;
+	for (const std::string& criterion : { "BIC", "ICL", "lnObservedLikelihood", "lnCompletedLikelihood" }) {
+		summary[criterion] = { dummyNames, Vector<Real>() };
+		out.get_payload( { "summary" }, criterion, summary[criterion]);
+		ASSERT_EQ(summary[criterion].vec_.size(), nFit);
+	}
+
+	for (Index f = 0; f < nFit; ++f) {
+		std::string key = std::to_string(vecNClass[f]);
+		ASSERT_EQ(warnLogFit[f], "");
+
+		JSONGraph algoLearn, outLearn; // learn run separately on the same number of classes
+		learnInput(algoLearn, data, desc);
+		algoLearn.add_payload( { }, "nClass", vecNClass[f]);
+		learn(algoLearn, data, desc, outLearn);
+		ASSERT_FALSE(outLearn.exist_payload( { }, "warnLog"));
+
+		ASSERT_EQ(out.get_payload<Index>( { "res", key, "mixture" }, "nbFreeParameters"), nbFreeParameters[f]);
+		ASSERT_EQ(outLearn.get_payload<Index>( { "mixture" }, "nbFreeParameters"), nbFreeParameters[f]);
+
+		// The criteria are computed at parameters averaged over the SEM iterations. The seeds of the two runs differ, but
+		// on these separated classes the Monte Carlo error of the averages only moves the criteria at second order, by a
+		// few 1e-2 at most between runs. The tolerance is well above that, and well below the gap between nClass = 1 and 2.
+		for (const std::string& criterion : { "BIC", "ICL", "lnObservedLikelihood", "lnCompletedLikelihood" }) {
+			Real sweep = out.get_payload<Real>( { "res", key, "mixture" }, criterion);
+			ASSERT_EQ(sweep, summary[criterion].vec_(f)); // the summary table is filled from the same fit
+			ASSERT_NEAR(sweep, outLearn.get_payload<Real>( { "mixture" }, criterion), 1.);
+		}
+	}
+}
@@ -0,0 +1,264 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+/*
+ *  Project:    MixtComp
+ *  Created on: October 18, 2026
+ **/
+
+#include <map>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "MixtComp.h"
+#include "jsonIO.h"
+
+using namespace mixt;
+
+namespace {
+
+/**
+ * Composer with a single variable of the model idName and two classes. Its parameters and completed data are those of
+ * the SEM initialization. Every variable has missing or partially observed values, scattered between the fully observed ones.
+ */
+class ModelFixture {
+public:
+	ModelFixture(const std::string& idName) :
+			idName_(idName) {
+		nlohmann::json a;
+		a["nClass"] = nClass_;
+		a["nInd"] = nInd_;
+		a["nbBurnInIter"] = 10;
+		a["nbIter"] = 10;
+		a["nbGibbsBurnInIter"] = 10;
+		a["nbGibbsIter"] = 10;
+		a["nInitPerClass"] = nInitPerClass_;
+		a["nSemTry"] = 5;
+		a["confidenceLevel"] = 0.95;
+		a["ratioStableCriterion"] = 0.99;
+		a["nStableCriterion"] = 10;
+		algo_.set(a);
+
+		const Index overDispersed[] = { 0, 1, 1, 3, 8, 15 };
+		std::vector<std::string> gaussian(nInd_), multinomial(nInd_), poisson(nInd_), negativeBinomial(nInd_), weibull(nInd_), func(nInd_), rank(nInd_);
+		for (Index i = 0; i < nInd_; ++i) {
+			Index k = i % 2;
+			gaussian[i] = std::to_string(10. * k + Real((i * 37) % 11) / 10.);
+			multinomial[i] = std::to_string(1 + 2 * k + (i / 2) % 2);
+			poisson[i] = std::to_string(8 * k + i % 3);
+			negativeBinomial[i] = std::to_string((1 + 3 * k) * overDispersed[(i / 2) % 6] + 10 * k);
+			weibull[i] = std::to_string(1. + 5. * k + Real(i % 5) / 5.);
+
+			std::stringstream sstm;
+			for (Index t = 0; t < 20; ++t) {
+				Real x = (k == 0) ? Real(t) : 20. - Real(t);
+				sstm << (0 < t ? "," : "") << t << ":" << x + Real((i * 7 + t) % 5) / 10.;
+			}
+			func[i] = sstm.str();
+
+			rank[i] = (k == 0) ? ((i / 2) % 2 == 0 ? "1,2,3,4" : "2,1,3,4") : ((i / 2) % 2 == 0 ? "4,3,2,1" : "4,3,1,2");
+		}
+
+		gaussian[3] = "?";
+		gaussian[5] = "[1:3]";
+		gaussian[8] = "[-inf:2]";
+		gaussian[13] = "[12:+inf]";
+		multinomial[4] = "?";
+		multinomial[7] = "{3,4}";
+		multinomial[12] = "{1,2,3}";
+		poisson[2] = "?";
+		poisson[9] = "[5:12]";
+		poisson[14] = "[3:+inf]";
+		negativeBinomial[6] = "?";
+		negativeBinomial[11] = "[8:15]";
+		negativeBinomial[16] = "[2:+inf]";
+		weibull[1] = "?";
+		weibull[10] = "[1:2]";
+		weibull[15] = "[5:+inf]";
+		rank[17] = "?,?,?,?";
+		rank[18] = "1,{2 3},{2 3},4";
+		rank[19] = "4,{2 3},{1 3},{1 2}";
+
+		nlohmann::json d;
+		d["Gaussian1"] = gaussian;
+		d["Multinomial1"] = multinomial;
+		d["Poisson1"] = poisson;
+		d["NegativeBinomial1"] = negativeBinomial;
+		d["Weibull1"] = weibull;
+		d["Func1"] = func;
+		d["FuncSharedAlpha1"] = func;
+		d["Rank1"] = rank;
+		data_.set(d);
+
+		std::map<std::string, std::pair<std::string, std::string>> model = { { "Gaussian1", { "Gaussian", "" } }, { "Multinomial1", { "Multinomial", "" } }, {
+				"Poisson1", { "Poisson", "" } }, { "NegativeBinomial1", { "NegativeBinomial", "" } }, { "Weibull1", { "Weibull", "" } }, { "Func1", { "Func_CS",
+				"nSub: 2, nCoeff: 2" } }, { "FuncSharedAlpha1", { "Func_SharedAlpha_CS", "nSub: 2, nCoeff: 2" } }, { "Rank1", { "Rank_ISR", "" } } };
+		nlohmann::json m;
+		m[idName_] = { { "type", model[idName_].first }, { "paramStr", model[idName_].second } };
+		desc_.set(m);
+
+		composer_.reset(new MixtureComposer(algo_));
+		std::string warnLog;
+		warnLog += createAllMixtures(algo_, desc_, data_, param_, out_, *composer_);
+		warnLog += composer_->setDataParam(learning_, data_, param_, desc_);
+
+		if (0 == warnLog.size()) { // same initialization as SemStrategy, which can not run on invalid data
+			std::string initLog;
+			for (Index n = 0; n < nInitTry_; ++n) { // the estimation of n in the NegativeBinomial model can diverge on a random subset
+				composer_->initData();
+				composer_->initParam();
+				initLog = composer_->initParamSubPartition(nInitPerClass_);
+				if (0 == initLog.size()) {
+					initLog = composer_->initializeLatent();
+				}
+				if (0 == initLog.size()) {
+					break;
+				}
+			}
+			warnLog += initLog;
+		}
+
+		EXPECT_EQ(warnLog, "");
+	}
+
+	const IMixture& mixture() const {
+		return *composer_->v_mixtures()[0];
+	}
+
+	/**
+	 * lnCompletedProbabilityBlock must add lnCompletedProbability(i, k) to each cell, for blocks that start at 0 and
+	 * elsewhere.
+	 */
+	void checkCompletedBlock() const {
+		checkBlock(&IMixture::lnCompletedProbabilityBlock, &IMixture::lnCompletedProbability, 1.);
+	}
+
+	/**
+	 * lnObservedProbabilityBlock must overwrite each cell with lnObservedProbability(i, k), in particular for the
+	 * missing and partially observed values.
+	 */
+	void checkObservedBlock() const {
+		checkBlock(&IMixture::lnObservedProbabilityBlock, &IMixture::lnObservedProbability, 0.);
+	}
+
+private:
+	typedef void (IMixture::*BlockFunc)(Index, Index, Matrix<Real>&) const;
+	typedef Real (IMixture::*CellFunc)(Index, Index) const;
+
+	/**
+	 * @param offset value that the block function must leave added to each cell of a matrix initialized at 1, that is 1
+	 * if it adds its log probabilities and 0 if it overwrites the cells
+	 */
+	void checkBlock(BlockFunc blockFunc, CellFunc cellFunc, Real offset) const {
+		const IMixture& m = mixture();
+
+		for (std::pair<Index, Index> block : { std::make_pair(Index(0), nInd_), std::make_pair(Index(3), nInd_ - 2), std::make_pair(nInd_ - 1, nInd_) }) {
+			Index iBegin = block.first;
+			Index iEnd = block.second;
+
+			Matrix<Real> lnProba(iEnd - iBegin, nClass_);
+			lnProba = 1.;
+			(m.*blockFunc)(iBegin, iEnd, lnProba);
+
+			for (Index k = 0; k < nClass_; ++k) {
+				for (Index i = iBegin; i < iEnd; ++i) {
+					Real expected = offset + (m.*cellFunc)(i, k);
+					if (expected == minInf) { // for example a modality that is not observed in a class
+						ASSERT_EQ(lnProba(i - iBegin, k), minInf);
+						continue;
+					}
+					ASSERT_NEAR(lnProba(i - iBegin, k), expected, 1e-10 * (1. + std::abs(expected)));
+				}
+			}
+		}
+	}
+
+	static const Index nClass_ = 2;
+	static const Index nInd_ = 40;
+	static const Index nInitPerClass_ = 20;
+	static const Index nInitTry_ = 10;
+
+	std::string idName_;
+	JSONGraph algo_, data_, desc_, param_, out_;
+	std::unique_ptr<MixtureComposer> composer_;
+};
+
+}
+
+TEST(Mixture, lnCompletedProbabilityBlockGaussian) {
+	ModelFixture model("Gaussian1");
+	model.checkCompletedBlock();
+}
+
+TEST(Mixture, lnCompletedProbabilityBlockMultinomial) {
+	ModelFixture model("Multinomial1");
+	model.checkCompletedBlock();
+}
+
+TEST(Mixture, lnCompletedProbabilityBlockPoisson) {
+	ModelFixture model("Poisson1");
+	model.checkCompletedBlock();
+}
+
+TEST(Mixture, lnCompletedProbabilityBlockNegativeBinomial) {
+	ModelFixture model("NegativeBinomial1");
+	model.checkCompletedBlock();
+}
+
+TEST(Mixture, lnCompletedProbabilityBlockWeibull) {
+	ModelFixture model("Weibull1");
+	model.checkCompletedBlock();
+}
+
+TEST(Mixture, lnCompletedProbabilityBlockFunc) {
+	ModelFixture model("Func1");
+	model.checkCompletedBlock();
+}
+
+TEST(Mixture, lnCompletedProbabilityBlockFuncSharedAlpha) {
+	ModelFixture model("FuncSharedAlpha1");
+	model.checkCompletedBlock();
+}
+
+TEST(Mixture, lnCompletedProbabilityBlockRank) {
+	ModelFixture model("Rank1");
+	model.checkCompletedBlock();
+}
+
+TEST(Mixture, lnObservedProbabilityBlockGaussian) {
+	ModelFixture model("Gaussian1");
+	model.checkObservedBlock();
+}
+
+TEST(Mixture, lnObservedProbabilityBlockMultinomial) {
+	ModelFixture model("Multinomial1");
+	model.checkObservedBlock();
+}
+
+TEST(Mixture, lnObservedProbabilityBlockPoisson) {
+	ModelFixture model("Poisson1");
+	model.checkObservedBlock();
+}
+
+TEST(Mixture, lnObservedProbabilityBlockNegativeBinomial) {
+	ModelFixture model("NegativeBinomial1");
+	model.checkObservedBlock();
+}
+
+TEST(Mixture, lnObservedProbabilityBlockWeibull) {
+	ModelFixture model("Weibull1");
+	model.checkObservedBlock();
+}
@@ -0,0 +1,81 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+/**
+ * Comparison of the computation of the t_ik row by row with logToMulti, as done before, and by blocks of rows with
+ * logToMultiRows, as done in MixtureComposer. Usage: runBench [nInd] [nClass] [nRep]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include <MixtComp.h>
+
+using namespace mixt;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+Real elapsed(Clock::time_point start) {
+	return std::chrono::duration<Real>(Clock::now() - start).count();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	Index nInd = (1 < argc) ? std::atol(argv[1]) : 100000;
+	Index nClass = (2 < argc) ? std::atol(argv[2]) : 10;
+	Index nRep = (3 < argc) ? std::atol(argv[3]) : 20;
+
+	Matrix<Real> logProba(nInd, nClass);
+	for (Index i = 0; i < nInd; ++i) {
+		for (Index k = 0; k < nClass; ++k) {
+			logProba(i, k) = -100.0 + 50.0 * std::sin(Real(i * nClass + k));
+		}
+	}
+
+	Matrix<Real> tik(nInd, nClass);
+	Vector<Real> logNorm(nInd);
+	Real checkRow = 0.;
+	Real checkBlock = 0.;
+
+	Clock::time_point start = Clock::now();
+	for (Index r = 0; r < nRep; ++r) {
+		for (Index i = 0; i < nInd; ++i) {
+			logNorm(i) = tik.row(i).logToMulti(logProba.row(i));
+		}
+		checkRow += logNorm.sum();
+	}
+	Real timeRow = elapsed(start) / nRep;
+
+	start = Clock::now();
+	for (Index r = 0; r < nRep; ++r) {
+		tik = logProba;
+		logToMultiRows(tik, logNorm);
+		checkBlock += logNorm.sum();
+	}
+	Real timeBlock = elapsed(start) / nRep; // includes the copy of logProba, which is also done by logToMulti
+
+	std::cout << "nInd: " << nInd << ", nClass: " << nClass << ", nRep: " << nRep << std::endl;
+	std::cout << "logToMulti by row: " << timeRow << " s" << std::endl;
+	std::cout << "logToMultiRows: " << timeBlock << " s" << std::endl;
+	std::cout << "speedup: " << timeRow / timeBlock << std::endl;
+	std::cout << "relative difference of the log normalizers: " << std::abs(checkRow - checkBlock) / std::abs(checkRow) << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,104 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+/**
+ * Throughput of the parsers of the missing values, MisValRegexParser and MisValScanParser, on a column mixing present
+ * values and every kind of missing value, as StringToAugmentedData does. The results of the two parsers are compared.
+ * Usage: runBenchMisValParser [nInd] [nRep]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include <MixtComp.h>
+
+using namespace mixt;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+Real elapsed(Clock::time_point start) {
+	return std::chrono::duration<Real>(Clock::now() - start).count();
+}
+
+/** Parse the whole column nRep times, the results of the last repetition are kept. */
+template<typename Parser>
+Real parseColumn(const std::vector<std::string>& column, Index nRep, std::vector<Real>& val, std::vector<typename Parser::MisVal>& misVal) {
+	Parser parser(0.);
+	Index nInd = column.size();
+
+	Clock::time_point start = Clock::now();
+	for (Index r = 0; r < nRep; ++r) {
+		for (Index i = 0; i < nInd; ++i) {
+			misVal[i] = typename Parser::MisVal();
+			parser.parseStr(column[i], val[i], misVal[i]);
+		}
+	}
+	return elapsed(start) / nRep;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	Index nInd = (1 < argc) ? std::atol(argv[1]) : 100000;
+	Index nRep = (2 < argc) ? std::atol(argv[2]) : 5;
+
+	std::vector<std::string> column(nInd);
+	for (Index i = 0; i < nInd; ++i) { // mostly present values, as in real data sets
+		Real x = 100.0 * std::sin(Real(i));
+		switch (i % 10) {
+		case 0:
+			column[i] = "?";
+			break;
+		case 1:
+			column[i] = "[" + type2str(x) + ":" + type2str(x + 1.5) + "]";
+			break;
+		case 2:
+			column[i] = "[-inf:" + type2str(x) + "]";
+			break;
+		case 3:
+			column[i] = "{" + type2str(x) + ", " + type2str(2. * x) + ", 3.5e-2}";
+			break;
+		default:
+			column[i] = type2str(x);
+			break;
+		}
+	}
+
+	std::vector<Real> valRegex(nInd), valScan(nInd);
+	std::vector<MisValRegexParser<Real>::MisVal> misValRegex(nInd);
+	std::vector<MisValScanParser<Real>::MisVal> misValScan(nInd);
+
+	Real timeRegex = parseColumn<MisValRegexParser<Real>>(column, nRep, valRegex, misValRegex);
+	Real timeScan = parseColumn<MisValScanParser<Real>>(column, nRep, valScan, misValScan);
+
+	Index nDiff = 0;
+	for (Index i = 0; i < nInd; ++i) {
+		if (misValRegex[i] != misValScan[i] || (misValRegex[i].first == present_ && valRegex[i] != valScan[i])) {
+			++nDiff;
+		}
+	}
+
+	std::cout << "nInd: " << nInd << ", nRep: " << nRep << std::endl;
+	std::cout << "MisValRegexParser: " << timeRegex << " s, " << nInd / timeRegex << " strings / s" << std::endl;
+	std::cout << "MisValScanParser: " << timeScan << " s, " << nInd / timeScan << " strings / s" << std::endl;
+	std::cout << "speedup: " << timeRegex / timeScan << std::endl;
+	std::cout << "number of different results: " << nDiff << std::endl;
+
+	return 0;
+}
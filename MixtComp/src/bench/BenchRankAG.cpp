@@ -0,0 +1,101 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+/**
+ * Time per call of RankISRIndividual::AG, which counts the comparisons of the insertion sort with rank and select
+ * queries on bit vectors, and of RankISRIndividual::AGInsertion, which replays the insertion sort, for nbPos from 5 to
+ * 100. The results are compared.
+ * Usage: runBenchRankAG [nInd] [nRep]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+#include <MixtComp.h>
+
+using namespace mixt;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+Real elapsed(Clock::time_point start) {
+	return std::chrono::duration<Real>(Clock::now() - start).count();
+}
+
+typedef std::pair<MisType, std::vector<int> > MisVal;
+
+/** Call the counting method on every individual nRep times, and return the mean time per call. */
+template<typename Method>
+Real countAll(const Vector<RankISRIndividual>& data, const RankVal& mu, Index nRep, Method method, std::vector<int>& res) {
+	Index nInd = data.size();
+	Clock::time_point start = Clock::now();
+	for (Index r = 0; r < nRep; ++r) {
+		for (Index i = 0; i < nInd; ++i) {
+			int a, g;
+			(data(i).*method)(mu, a, g);
+			res[2 * i] = a;
+			res[2 * i + 1] = g;
+		}
+	}
+	return elapsed(start) / (nRep * nInd);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	Index nInd = (1 < argc) ? std::atol(argv[1]) : 1000;
+	Index nRep = (2 < argc) ? std::atol(argv[2]) : 20;
+
+	MultinomialStatistic multi;
+
+	std::cout << "nbPos\tinsertion (ns)\tcounting (ns)\tspeed-up\tdifferences" << std::endl;
+	for (int nbPos : { 5, 10, 20, 40, 70, 100 }) {
+		Vector<MisVal> obsData(nbPos, MisVal(missing_, { }));
+		Vector<int> vec(nbPos);
+
+		std::iota(vec.begin(), vec.end(), 0);
+		multi.shuffle(vec);
+		RankVal mu(nbPos);
+		mu.setO(vec);
+
+		Vector<RankISRIndividual> data(nInd);
+		for (Index i = 0; i < nInd; ++i) { // random x and presentation order
+			data(i).setNbPos(nbPos);
+			data(i).setObsData(obsData);
+			data(i).removeMissing();
+			std::iota(vec.begin(), vec.end(), 0);
+			multi.shuffle(vec);
+			data(i).setO(vec);
+		}
+
+		std::vector<int> resInsertion(2 * nInd);
+		std::vector<int> resCounting(2 * nInd);
+		Real timeInsertion = countAll(data, mu, nRep, &RankISRIndividual::AGInsertion, resInsertion);
+		Real timeCounting = countAll(data, mu, nRep, &RankISRIndividual::AG, resCounting);
+
+		Index nDiff = 0;
+		for (Index k = 0; k < 2 * nInd; ++k) {
+			nDiff += (resInsertion[k] != resCounting[k]);
+		}
+
+		std::cout << nbPos << "\t" << 1e9 * timeInsertion << "\t" << 1e9 * timeCounting << "\t" << timeInsertion / timeCounting << "\t" << nDiff << std::endl;
+	}
+
+	return 0;
+}
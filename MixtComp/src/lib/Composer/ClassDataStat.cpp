@@ -61,7 +61,7 @@ void ClassDataStat::imputeData(int ind, Matrix<Real>& tik) {
 		int mode;
 		tik.row(ind) = dataStatStorage_.row(ind); // completed tik from last sampling are replaced by observed tik
 		dataStatStorage_.row(ind).maxCoeff(&mode);
-		zClassInd_.setZAndClassInd(ind, mode);
+		zClassInd_.setZ(ind, mode);
 	}
 }
 
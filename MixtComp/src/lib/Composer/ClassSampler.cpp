@@ -47,8 +47,8 @@ void ClassSampler::sStepNoCheck(int i) {
 		case missingFiniteValues_: { // renormalize proba distribution on allowed sampling values
 			Vector<Real> modalities(nbClass_, 0.);
 
-			for(std::vector<Index>::const_iterator currMod = zClassInd_.zi().misData_(i).second.begin(),
-					endMod  = zClassInd_.zi().misData_(i).second.end();
+			for(const Index* currMod = zClassInd_.zi().misData_(i).second.begin(),
+					*endMod  = zClassInd_.zi().misData_(i).second.end();
 					currMod != endMod;
 					++currMod) {
 				modalities(*currMod) = tik_(i, *currMod);
@@ -61,7 +61,7 @@ void ClassSampler::sStepNoCheck(int i) {
 		default: {}
 		break;
 		}
-		zClassInd_.setZAndClassInd(i, sampleVal);
+		zClassInd_.setZ(i, sampleVal);
 	}
 }
 } // namespace mixt
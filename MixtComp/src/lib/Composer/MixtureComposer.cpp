@@ -22,6 +22,8 @@
  *              Serge IOVLEFF <serge.iovleff@inria.fr>
  **/
 
+#include <algorithm>
+#include <exception>
 #include <IO/IO.h>
 #include <LinAlg/LinAlg.h>
 #include <list>
@@ -44,7 +46,7 @@ Real MixtureComposer::lnObservedProbability(int i, int k) const {
 	Real sum = std::log(prop_[k]); // the joint probability p(x, z) is computed here, and will be marginalized over z later, for example in observedTik method
 
 	for (Index j = 0; j < nVar_; ++j) { // use the cache
-		sum += observedProbabilityCache_(j)(i, k);
+		sum += observedProbabilityCache_(k, j * nInd_ + i);
 	}
 
 	return sum;
@@ -59,8 +61,6 @@ void MixtureComposer::printTik() const {
 
 void MixtureComposer::observedTik(Vector<Real>& oZMode) const {
 	oZMode.resize(nInd_);
-	Matrix<Real> observedTikMat(nInd_, nClass_);
-
 	Matrix<Real> lnComp(nInd_, nClass_);
 
 	for (Index k = 0; k < nClass_; ++k) {
@@ -69,11 +69,12 @@ void MixtureComposer::observedTik(Vector<Real>& oZMode) const {
 		}
 	}
 
+	Vector<Real> logNorm;
+	logToMultiRows(lnComp, logNorm); // sum is inside a log, hence the normalization by rows
+
 	Index mode;
-	for (Index i = 0; i < nInd_; ++i) { // sum is inside a log, hence the numerous steps for the computation
-		RowVector<Real> dummy;
-		observedTikMat.row(i).logToMulti(lnComp.row(i));
-		observedTikMat.row(i).maxCoeff(&mode);
+	for (Index i = 0; i < nInd_; ++i) {
+		lnComp.row(i).maxCoeff(&mode);
 
 		oZMode(i) = mode;
 	}
@@ -83,7 +84,6 @@ void MixtureComposer::observedTik(Vector<Real>& oZMode) const {
 }
 
 Real MixtureComposer::lnObservedLikelihood() const {
-	Real lnLikelihood = 0.;
 	Matrix<Real> lnObs(nInd_, nClass_);
 
 	for (Index k = 0; k < nClass_; ++k) {
@@ -92,12 +92,10 @@ Real MixtureComposer::lnObservedLikelihood() const {
 		}
 	}
 
-	for (Index i = 0; i < nInd_; ++i) { // sum is inside a log, hence the numerous steps for the computation
-		RowVector<Real> dummy;
-		lnLikelihood += dummy.logToMulti(lnObs.row(i));
-	}
+	Vector<Real> logNorm;
+	logToMultiRows(lnObs, logNorm); // sum is inside a log, hence the normalization by rows
 
-	return lnLikelihood;
+	return logNorm.sum();
 }
 
 Real MixtureComposer::lnCompletedLikelihood() const {
@@ -110,6 +108,14 @@ Real MixtureComposer::lnCompletedLikelihood() const {
 	return lnLikelihood;
 }
 
+Real MixtureComposer::BIC() const {
+	return lnObservedLikelihood() - 0.5 * nbFreeParameters() * std::log(nInd_);
+}
+
+Real MixtureComposer::ICL() const {
+	return lnCompletedLikelihood() - 0.5 * nbFreeParameters() * std::log(nInd_);
+}
+
 Real MixtureComposer::lnCompletedProbability(int i, int k) const {
 	Real sum = std::log(prop_[k]); // the joint probability p(x, z) is computed
 
@@ -120,70 +126,241 @@ Real MixtureComposer::lnCompletedProbability(int i, int k) const {
 	return sum;
 }
 
-std::string MixtureComposer::mStep(const Vector<std::set<Index>>& classInd) {
+std::string MixtureComposer::setVariableDataParam(RunMode mode, const MixtureComposer* p_source, Index nThread) {
+	std::vector<std::string> vecWarnLog(nVar_);
+	std::vector<std::exception_ptr> vecException(nVar_);
+	readTime_.resize(nVar_);
+
+#pragma omp parallel for num_threads(nThread) schedule(dynamic, 1) // the costs of the variables can be very different
+	for (Index v = 0; v < nVar_; ++v) {
+		Timer readTimer;
+
+		try {
+			if (p_source == nullptr) {
+				vecWarnLog[v] = v_mixtures_[v]->setDataParam(mode);
+			} else {
+				vecWarnLog[v] = v_mixtures_[v]->setDataParam(mode, *p_source->v_mixtures_[v]);
+			}
+		} catch (...) { // an exception must not leave the parallel region
+			vecException[v] = std::current_exception();
+		}
+
+		readTime_(v) = readTimer.finish();
+	}
+
+	std::string warnLog;
+	for (Index v = 0; v < nVar_; ++v) {
+#ifdef MC_VERBOSE
+		std::cout << "MixtureComposer::setDataParam, " << v_mixtures_[v]->idName() << ": " << readTime_(v) << " s" << std::endl;
+#endif
+		if (vecException[v]) {
+			std::rethrow_exception(vecException[v]);
+		}
+
+		warnLog += vecWarnLog[v];
+	}
+
+	return warnLog;
+}
+
+NamedVector<Real> MixtureComposer::readTime() const {
+	std::vector<std::string> varNames(nVar_);
+	for (Index v = 0; v < nVar_; ++v) {
+		varNames[v] = v_mixtures_[v]->idName();
+	}
+
+	return NamedVector<Real> { varNames, readTime_ };
+}
+
+std::string MixtureComposer::mStep(const Vector<std::vector<Index>>& classInd, const std::vector<Index>* movedInd) {
 	mStepPi(); // computation of z_ik frequencies, which correspond to ML estimator of proportions
 
 	std::vector<std::string> vecWarnLog(nVar_);
+	Index epoch = rngEpoch_++;
 
-#pragma omp parallel for // note that this is the only case where parallelism is not performed over observations, but over individuals
+#pragma omp parallel for num_threads(nThread_) // parts of the estimation shared by all classes, parallelism is performed over variables
 	for (Index v = 0; v < nVar_; ++v) {
-		std::string currLog;
-		currLog = v_mixtures_[v]->mStep(classInd); // call mStep on each variable
-		if (0 < currLog.size()) {
-			vecWarnLog[v] = "mStep error in variable: " + v_mixtures_[v]->idName() + eol + currLog + eol;
+		RNGStream stream(rngSeed_, epoch, RNGStream::all, v);
+		vecWarnLog[v] = v_mixtures_[v]->mStepShared(classInd, movedInd);
+	}
+
+	Index nUnit = nVar_ * nClass_; // a unit is the estimation of the parameters of one class in one variable
+	std::vector<std::pair<Real, Index>> unit(nUnit); // (cost, v * nClass_ + k)
+	for (Index v = 0; v < nVar_; ++v) {
+		for (Index k = 0; k < nClass_; ++k) {
+			unit[v * nClass_ + k] = std::make_pair(v_mixtures_[v]->mStepCost(classInd, k), v * nClass_ + k);
 		}
 	}
+	std::stable_sort(unit.begin(), unit.end(), [](const std::pair<Real, Index>& a, const std::pair<Real, Index>& b) {
+		return a.first > b.first;
+	}); // most expensive units first, so that the cheap ones fill the gaps at the end
+
+	std::vector<std::string> unitWarnLog(nUnit);
+
+#pragma omp parallel for num_threads(nThread_) schedule(dynamic, 1) // units are handed out one at a time to the first idle thread
+	for (Index u = 0; u < nUnit; ++u) {
+		Index v = unit[u].second / nClass_;
+		Index k = unit[u].second % nClass_;
+		RNGStream stream(rngSeed_, epoch, k, v); // the class takes the place of the individual in the stream identifier
+		unitWarnLog[unit[u].second] = v_mixtures_[v]->mStep(classInd, k);
+	}
 
 	std::string warnLog;
-	for (std::vector<std::string>::const_iterator i = vecWarnLog.begin(); i != vecWarnLog.end(); ++i)
-		warnLog += *i;
+	for (Index v = 0; v < nVar_; ++v) {
+		std::string currLog = vecWarnLog[v];
+		for (Index k = 0; k < nClass_; ++k) {
+			currLog += unitWarnLog[v * nClass_ + k];
+		}
+
+		if (0 < currLog.size()) {
+			warnLog += "mStep error in variable: " + v_mixtures_[v]->idName() + eol + currLog + eol;
+		}
+	}
 
 	return warnLog;
 }
 
 std::string MixtureComposer::mStep() {
-	return mStep(zClassInd_.classInd());
+	std::string warnLog = mStep(zClassInd_.classInd(), &zClassInd_.movedInd());
+	zClassInd_.clearMovedInd();
+	return warnLog;
 }
 
 void MixtureComposer::sampleZ() {
-#pragma omp parallel for
+	Index epoch = rngEpoch_++;
+
+#pragma omp parallel for num_threads(nThread_)
 	for (Index i = 0; i < nInd_; ++i) {
+		RNGStream stream(rngSeed_, epoch, i, RNGStream::all);
 		sampleZ(i);
 	}
+
+	zClassInd_.computeClassInd();
 }
 
 
 void MixtureComposer::sampleZProportion() {
-#pragma omp parallel for
+	Index epoch = rngEpoch_++;
+
+#pragma omp parallel for num_threads(nThread_)
 	for (Index i = 0; i < nInd_; ++i) {
+		RNGStream stream(rngSeed_, epoch, i, RNGStream::all);
 		tik_.row(i) = prop_;
 		sampleZ(i);
 	}
+
+	zClassInd_.computeClassInd();
 }
 
 void MixtureComposer::sampleZ(int i) {
 	sampler_.sStepNoCheck(i);
 }
 
+void MixtureComposer::lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnComp) const {
+	lnComp.resize(iEnd - iBegin, nClass_);
+	for (Index k = 0; k < nClass_; ++k) {
+		lnComp.col(k) = Vector<Real>(iEnd - iBegin, std::log(prop_[k])); // the joint probability p(x, z) is computed
+	}
+
+	for (ConstMixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it) { // one virtual call per variable for the whole block
+		(*it)->lnCompletedProbabilityBlock(iBegin, iEnd, lnComp);
+	}
+}
+
+void MixtureComposer::lnCompletedProbabilityBlockCached(Index iBegin, Index iEnd, Matrix<Real>& lnComp) {
+	Index nIndBlock = iEnd - iBegin;
+	lnComp.resize(nIndBlock, nClass_);
+	for (Index k = 0; k < nClass_; ++k) {
+		lnComp.col(k) = Vector<Real>(nIndBlock, std::log(prop_[k]));
+	}
+
+	Matrix<Real> lnVar;
+	for (Index j = 0; j < nVar_; ++j) {
+		switch (completedCacheMode_[j]) {
+			case notCached_: {
+				v_mixtures_[j]->lnCompletedProbabilityBlock(iBegin, iEnd, lnComp);
+			}
+			break;
+
+			case refreshAll_: {
+				lnVar.setZero(nIndBlock, nClass_);
+				v_mixtures_[j]->lnCompletedProbabilityBlock(iBegin, iEnd, lnVar);
+				completedVarCache_[j].middleRows(iBegin, nIndBlock) = lnVar;
+				lnComp += lnVar;
+			}
+			break;
+
+			case refreshStale_: { // the stale individuals of the block are recomputed by runs of consecutive indices
+				const std::vector<Index>& stale = staleInd_[j];
+				std::vector<Index>::const_iterator it = std::lower_bound(stale.begin(), stale.end(), iBegin);
+				while (it != stale.end() && *it < iEnd) {
+					std::vector<Index>::const_iterator itRun = it + 1;
+					while (itRun != stale.end() && *itRun < iEnd && *itRun == *(itRun - 1) + 1) {
+						++itRun;
+					}
+
+					Index runBegin = *it;
+					Index runEnd = *(itRun - 1) + 1;
+					lnVar.setZero(runEnd - runBegin, nClass_);
+					v_mixtures_[j]->lnCompletedProbabilityBlock(runBegin, runEnd, lnVar);
+					completedVarCache_[j].middleRows(runBegin, runEnd - runBegin) = lnVar;
+
+					it = itRun;
+				}
+
+				lnComp += completedVarCache_[j].middleRows(iBegin, nIndBlock);
+			}
+			break;
+		}
+	}
+}
+
+void MixtureComposer::setCompletedCacheMode() {
+	completedVarCache_.resize(nVar_);
+	staleInd_.resize(nVar_);
+	completedCacheMode_.resize(nVar_);
+
+	for (Index j = 0; j < nVar_; ++j) {
+		bool allStale = v_mixtures_[j]->staleCompletedProbability(staleInd_[j]);
+
+		if (!allStale && completedVarCache_[j].size() == 0) { // the variable can be cached, its cache is allocated and filled at this E step
+			completedVarCache_[j].resize(nInd_, nClass_);
+			allStale = true;
+		}
+
+		if (completedVarCache_[j].size() == 0) {
+			completedCacheMode_[j] = notCached_;
+		} else if (allStale) {
+			completedCacheMode_[j] = refreshAll_;
+		} else {
+			completedCacheMode_[j] = refreshStale_;
+		}
+	}
+}
+
 void MixtureComposer::eStepCompleted() {
 	bool *correct = new bool[nInd_];// std::vector<bool> causes errors in parallel writes: https://stackoverflow.com/questions/33617421/write-concurrently-vectorbool and http://www.cplusplus.com/reference/vector/. https://stackoverflow.com/questions/11379433/c-forbids-variable-size-array/11379442#11379442
 
-#pragma omp parallel for
-	for (Index i = 0; i < nInd_; ++i) {
-		RowVector<Real> lnComp(nClass_);
+	setCompletedCacheMode(); // the mixtures are queried outside of the parallel region
 
-		bool correctVal = true;
+	Index nBlock = (nInd_ + nIndPerBlock - 1) / nIndPerBlock;
 
-		for (Index k = 0; k < nClass_; k++) {
-			lnComp(k) = lnCompletedProbability(i, k);
-		}
+#pragma omp parallel for num_threads(nThread_) schedule(dynamic)
+	for (Index b = 0; b < nBlock; ++b) {
+		Index iBegin = b * nIndPerBlock;
+		Index iEnd = std::min(iBegin + nIndPerBlock, nInd_);
+
+		Matrix<Real> lnComp;
+		lnCompletedProbabilityBlockCached(iBegin, iEnd, lnComp);
 
-		if (minInf == lnComp.maxCoeff()) { // completed proba is non 0 in at least one class
-			correctVal = false;
+		for (Index i = iBegin; i < iEnd; ++i) {
+			correct[i] = minInf < lnComp.row(i - iBegin).maxCoeff(); // completed proba is non 0 in at least one class
 		}
 
-		completedProbabilityCache_(i) = tik_.row(i).logToMulti(lnComp);
-		correct[i] = correctVal;
+		Vector<Real> logNorm;
+		logToMultiRows(lnComp, logNorm);
+		tik_.middleRows(iBegin, iEnd - iBegin) = lnComp;
+		completedProbabilityCache_.segment(iBegin, iEnd - iBegin) = logNorm;
 	}
 	std::list<Index> listIndErr;
 	for (Index i = 0; i < nInd_; ++i) {
@@ -212,19 +389,19 @@ void MixtureComposer::eStepCompleted() {
 }
 
 bool MixtureComposer::eStepCompleted(Index i) {
-	RowVector<Real> lnComp(nClass_);
+	Matrix<Real> lnComp;
+	lnCompletedProbabilityBlock(i, i + 1, lnComp);
 
 	bool correctVal = true;
 
-	for (Index k = 0; k < nClass_; k++) {
-		lnComp(k) = lnCompletedProbability(i, k);
-	}
-
-	if (minInf == lnComp.maxCoeff()) { // completed proba is non 0 in at least one class
+	if (minInf == lnComp.row(0).maxCoeff()) { // completed proba is non 0 in at least one class
 		correctVal = false;
 	}
 
-	completedProbabilityCache_(i) = tik_.row(i).logToMulti(lnComp);
+	Vector<Real> logNorm;
+	logToMultiRows(lnComp, logNorm);
+	tik_.row(i) = lnComp.row(0);
+	completedProbabilityCache_(i) = logNorm(0);
 
 	return correctVal;
 }
@@ -260,8 +437,11 @@ int MixtureComposer::nbFreeParameters() const {
 }
 
 void MixtureComposer::sampleUnobservedAndLatent() {
-#pragma omp parallel for
+	Index epoch = rngEpoch_++;
+
+#pragma omp parallel for num_threads(nThread_)
 	for (Index i = 0; i < nInd_; ++i) {
+		RNGStream stream(rngSeed_, epoch, i, RNGStream::all);
 		sampleUnobservedAndLatent(i);
 	}
 }
@@ -272,7 +452,7 @@ void MixtureComposer::sampleUnobservedAndLatent(int i) {
 	}
 }
 
-std::string MixtureComposer::checkSampleCondition(const Vector<std::set<Index>>& classInd) const {
+std::string MixtureComposer::checkSampleCondition(const Vector<std::vector<Index>>& classInd) const {
 	std::string warnLog = checkNbIndPerClass(classInd);
 	for (ConstMixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it) {
 		warnLog += (*it)->checkSampleCondition(classInd);
@@ -285,7 +465,7 @@ std::string MixtureComposer::checkSampleCondition() const {
 	return checkSampleCondition(zClassInd_.classInd());
 }
 
-std::string MixtureComposer::checkNbIndPerClass(const Vector<std::set<Index>>& classInd) const {
+std::string MixtureComposer::checkNbIndPerClass(const Vector<std::vector<Index>>& classInd) const {
 	for (Index k = 0; k < nClass_; ++k) {
 		if (0 < classInd(k).size()) {
 			continue;
@@ -348,24 +528,30 @@ void MixtureComposer::setObservedProbaCache() {
 #ifdef MC_VERBOSE
 	std::cout << "MixtureComposer::setObservedProbaCache, this operation could take some time..." << std::endl;
 #endif
-	observedProbabilityCache_.resize(nVar_);
+	observedProbabilityCache_.resize(nClass_, nVar_ * nInd_);
 
-	for (Index j = 0; j < nVar_; ++j) {
-		observedProbabilityCache_(j) = Matrix<Real>(nInd_, nClass_);
-		observedProbabilityCache_(j) = 0.;
-	}
+	Index nBlock = (nInd_ + nIndPerBlock - 1) / nIndPerBlock; // blocks per variable
+	Index nUnit = nVar_ * nBlock;
 
-	for (Index j = 0; j < nVar_; ++j) {
-#pragma omp parallel for
-		for (Index i = 0; i < nInd_; ++i) {
-			for (Index k = 0; k < nClass_; ++k) {
-				observedProbabilityCache_(j)(i, k) = v_mixtures_[j]->lnObservedProbability(i, k);
-			}
-		}
+#pragma omp parallel for num_threads(nThread_) schedule(dynamic) // a single parallel region over all (variable, block of individuals) units
+	for (Index u = 0; u < nUnit; ++u) {
+		Index j = u / nBlock;
+		Index iBegin = (u % nBlock) * nIndPerBlock;
+		Index iEnd = std::min(iBegin + nIndPerBlock, nInd_);
+
+		Matrix<Real> lnProba(iEnd - iBegin, nClass_);
+		v_mixtures_[j]->lnObservedProbabilityBlock(iBegin, iEnd, lnProba);
+		observedProbabilityCache_.block(0, j * nInd_ + iBegin, nClass_, iEnd - iBegin) = lnProba.transpose();
 	}
 }
 
 void MixtureComposer::storeGibbsRun(Index iteration, Index iterationMax) {
+	if (iteration == 0) {
+		for (MixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it) {
+			(*it)->beginGibbsRun(iterationMax);
+		}
+	}
+
 	for (Index ind = 0; ind < nInd_; ++ind) {
 		dataStat_.sampleVals(ind, iteration, iterationMax);
 
@@ -377,6 +563,14 @@ void MixtureComposer::storeGibbsRun(Index iteration, Index iterationMax) {
 			(*it)->storeGibbsRun(ind, iteration, iterationMax);
 		}
 	}
+
+	if (iteration == iterationMax) {
+		for (MixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it) {
+			(*it)->endGibbsRun();
+		}
+
+		zClassInd_.computeClassInd(); // z has been imputed
+	}
 }
 
 void MixtureComposer::registerMixture(IMixture* p_mixture) {
@@ -408,10 +602,13 @@ void MixtureComposer::initData() {
 	tik_ = 1. / nClass_;
 	sampleZ(); // since tik are uniform, this sStep corresponds to an uniform initialization of z. It takes into account the supervised / semi-supervised constraints
 
-	for (MixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it) {
-#pragma omp parallel for
+	for (Index j = 0; j < nVar_; ++j) {
+		Index epoch = rngEpoch_++;
+
+#pragma omp parallel for num_threads(nThread_)
 		for (Index i = 0; i < nInd_; ++i) {
-			(*it)->initData(i);
+			RNGStream stream(rngSeed_, epoch, i, j);
+			v_mixtures_[j]->initData(i);
 		}
 	}
 }
@@ -419,6 +616,8 @@ void MixtureComposer::initData() {
 void MixtureComposer::initParam() {
 	prop_ = 1. / nClass_; // this is roughly equivalent to an estimation by maximization of likelihood, considering that proportions in all t_ik are equal
 
+	RNGStream stream(rngSeed_, rngEpoch_++, RNGStream::all, RNGStream::all);
+
 	for (MixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it) {
 		(*it)->initParam();
 	}
@@ -427,7 +626,7 @@ void MixtureComposer::initParam() {
 std::string MixtureComposer::initParamSubPartition(Index nInitPerClass) {
 	std::string warnLog;
 
-	Vector<std::set<Index>> partialClassInd(nClass_);
+	Vector<std::vector<Index>> partialClassInd(nClass_);
 	Index nSubset = std::min(nInitPerClass * nClass_, nInd_);
 
 #ifdef MC_VERBOSE
@@ -439,12 +638,19 @@ std::string MixtureComposer::initParamSubPartition(Index nInitPerClass) {
 		allInd(i) = i;
 	}
 
-	MultinomialStatistic multi;
-	multi.shuffle(allInd);
+	{
+		RNGStream stream(rngSeed_, rngEpoch_++, RNGStream::all, RNGStream::all);
+		MultinomialStatistic multi;
+		multi.shuffle(allInd);
+	}
 
 	for (Index i = 0; i < nSubset; ++i) {
 		Index currInd = allInd(i);
-		partialClassInd(zClassInd_.zi().data_(currInd)).insert(currInd);
+		partialClassInd(zClassInd_.zi().data_(currInd)).push_back(currInd);
+	}
+
+	for (Index k = 0; k < nClass_; ++k) {
+		std::sort(partialClassInd(k).begin(), partialClassInd(k).end()); // same order as in the full partition
 	}
 
 //	for (Index k = 0; k < nClass_; ++k) {
@@ -471,7 +677,7 @@ void MixtureComposer::E_kj(Matrix<Real>& ekj, Matrix<Real>& ebarkj) const {
 			Vector<Real> lnP(nClass_); // ln(p(z_i = k, x_i^j))
 			Vector<Real> t_ik_j(nClass_); // p(z_i = k / x_i^j)
 			for (Index k = 0; k < nClass_; ++k) {
-				lnP(k) = std::log(prop_(k)) + observedProbabilityCache_(j)(i, k);
+				lnP(k) = std::log(prop_(k)) + observedProbabilityCache_(k, j * nInd_ + i);
 			}
 			t_ik_j.logToMulti(lnP); // "observed" t_ik, for the variable j
 
@@ -508,7 +714,7 @@ void MixtureComposer::Delta(Matrix<Real>& delta) const {
 		for (Index j = 0; j < nVar_; ++j) {
 			Vector<Real> lnP(nClass_); // ln(p(z_i = k, x_i^j))
 			for (Index k = 0; k < nClass_; ++k) {
-				lnP(k) = std::log(prop_(k)) + observedProbabilityCache_(j)(i, k);
+				lnP(k) = std::log(prop_(k)) + observedProbabilityCache_(k, j * nInd_ + i);
 			}
 			probacond.col(j).logToMulti(lnP); // "observed" t_ik, for the variable j
 		}
@@ -568,7 +774,9 @@ void MixtureComposer::printClassInd() const {
 }
 
 void MixtureComposer::computeObservedProba() {
+	Index epoch = rngEpoch_++;
 	for (Index j = 0; j < nVar_; ++j) {
+		RNGStream stream(rngSeed_, epoch, RNGStream::all, j);
 		v_mixtures_[j]->computeObservedProba();
 	}
 }
@@ -578,7 +786,9 @@ std::string MixtureComposer::initializeLatent() {
 
 	sampleZProportion();
 
+	Index epoch = rngEpoch_++;
 	for (Index i = 0; i < nInd_; ++i) { // TODO: could be parallelized over individuals
+		RNGStream stream(rngSeed_, epoch, i, RNGStream::all);
 		for (Index n = 0; n < nCompletedInitTry; ++n) {
 			sampleUnobservedAndLatent(i);
 			if (eStepCompleted(i))
@@ -614,8 +824,11 @@ std::string MixtureComposer::initializeLatent() {
 }
 
 void MixtureComposer::initializeMarkovChain() {
-#pragma omp parallel for
+	Index epoch = rngEpoch_++;
+
+#pragma omp parallel for num_threads(nThread_)
 	for (Index i = 0; i < nInd_; ++i) {
+		RNGStream stream(rngSeed_, epoch, i, RNGStream::all);
 		for (Index j = 0; j < nVar_; ++j) {
 			v_mixtures_[j]->initializeMarkovChain(i, zClassInd_.zi().data_(i));
 		}
@@ -623,11 +836,14 @@ void MixtureComposer::initializeMarkovChain() {
 }
 
 std::string MixtureComposer::eStepObserved() {
-	std::vector<bool> vecWarnLog(nInd_); // since the for loop can be executed in parallel, the individual results are stored in a vector to avoid race conditions
+	std::vector<char> vecWarnLog(nInd_); // since the for loop can be executed in parallel, the individual results are stored in a vector to avoid race conditions. std::vector<bool> is packed and can not be written concurrently, see eStepCompleted
 
-#pragma omp parallel for
-	for (Index i = 0; i < nInd_; ++i) {
-		vecWarnLog[i] = eStepObservedInd(i);
+	Index nBlock = (nInd_ + nIndPerBlock - 1) / nIndPerBlock;
+
+#pragma omp parallel for num_threads(nThread_) schedule(dynamic)
+	for (Index b = 0; b < nBlock; ++b) {
+		Index iBegin = b * nIndPerBlock;
+		eStepObservedBlock(iBegin, std::min(iBegin + nIndPerBlock, nInd_), vecWarnLog);
 	}
 
 	std::string tempWarnLog;
@@ -642,39 +858,38 @@ std::string MixtureComposer::eStepObserved() {
 		warnLog = "Error in MixtureComposer::eStepObserved: " + eol + tempWarnLog;
 	}
 
-//	std::cout << "MixtureComposer::eStepObservedInd, tik" << std::endl;
+//	std::cout << "MixtureComposer::eStepObservedBlock, tik" << std::endl;
 //	std::cout << tik_ << std::endl;
 
 	return warnLog;
 }
 
-bool MixtureComposer::eStepObservedInd(Index i) {
-	bool isIndividualObservable = true;
-
-	RowVector<Real> lnComp(nClass_); // row vector, one index per class
-	RowVector<Real> currVar(nClass_);
+void MixtureComposer::eStepObservedBlock(Index iBegin, Index iEnd, std::vector<char>& isIndividualObservable) {
+	Index nIndBlock = iEnd - iBegin;
+	Matrix<Real> lnComp(nIndBlock, nClass_); // one row per individual, one column per class
 
 	for (Index k = 0; k < nClass_; k++) {
-		lnComp(k) = std::log(prop_[k]);
+		lnComp.col(k).setConstant(std::log(prop_[k]));
 	}
 
 	for (Index j = 0; j < nVar_; ++j) {
-		for (Index k = 0; k < nClass_; k++) {
-			currVar(k) = observedProbabilityCache_(j)(i, k);
-		}
+		bool sampleApproximation = v_mixtures_[j]->sampleApproximationOfObservedProba();
+		auto currVar = observedProbabilityCache_.middleCols(j * nInd_ + iBegin, nIndBlock); // nClass x nIndBlock
 
-		if (minInf < currVar.maxCoeff() || !v_mixtures_[j]->sampleApproximationOfObservedProba()) {
-			lnComp += currVar;
+		for (Index i = 0; i < nIndBlock; ++i) {
+			if (minInf < currVar.col(i).maxCoeff() || !sampleApproximation) {
+				lnComp.row(i) += currVar.col(i).transpose();
+			}
 		}
 	}
 
-	if (lnComp.maxCoeff() == minInf) { // individual is not observable if its probability is 0 in every classes, in that case the run can not continue
-		isIndividualObservable = false;
+	for (Index i = 0; i < nIndBlock; ++i) { // individual is not observable if its probability is 0 in every classes, in that case the run can not continue
+		isIndividualObservable[iBegin + i] = minInf < lnComp.row(i).maxCoeff();
 	}
 
-	tik_.row(i).logToMulti(lnComp);
-
-	return isIndividualObservable;
+	Vector<Real> logNorm;
+	logToMultiRows(lnComp, logNorm);
+	tik_.middleRows(iBegin, nIndBlock) = lnComp;
 }
 
 void MixtureComposer::stabilityReset() {
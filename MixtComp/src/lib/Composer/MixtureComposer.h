@@ -28,13 +28,16 @@
 #include <Composer/ClassDataStat.h>
 #include <Composer/ClassSampler.h>
 #include <Composer/ZClassInd.h>
-#include <set>
 #include <vector>
+#include <IO/IOFunctions.h>
 #include <IO/NamedAlgebra.h>
 #include <LinAlg/LinAlg.h>
 #include <Mixture/IMixture.h>
 #include <Param/ConfIntParamStat.h>
+#include <Statistic/RNG.h>
+#include <Various/Constants.h>
 #include <Various/Enum.h>
+#include <Various/Various.h>
 
 namespace mixt {
 
@@ -49,13 +52,21 @@ public:
 	 */
 	template<typename Graph>
 	MixtureComposer(const Graph& algo) :
-			nClass_(algo.template get_payload<Index>( { }, "nClass")), nInd_(algo.template get_payload<Index>( { }, "nInd")),
+			MixtureComposer(algo, algo.template get_payload<Index>( { }, "nClass")) {
+	}
+
+	/** Constructor with a number of classes that is not read from algo, used to fit several values of nClass with the same algo. */
+	template<typename Graph>
+	MixtureComposer(const Graph& algo, Index nClass) :
+			nClass_(nClass), nInd_(algo.template get_payload<Index>( { }, "nInd")),
 			nVar_(0), confidenceLevel_(algo.template get_payload<Real>( { }, "confidenceLevel")), prop_(nClass_),
-			tik_(nInd_, nClass_, 0.), sampler_(zClassInd_, tik_, nClass_), paramStat_(prop_, confidenceLevel_),
+			tik_(nInd_, nClass_, 0.), sampler_(zClassInd_, tik_, nClass_), paramStat_(prop_, confidenceLevel_, paramStatMode(algo)),
 			dataStat_(zClassInd_), completedProbabilityCache_(nInd_), initialNIter_(0), lastPartition_(nInd_),
-			nConsecutiveStableIterations_(0) {
+			nConsecutiveStableIterations_(0), rngSeed_(seed(this)), rngEpoch_(0) {
+		std::string warnLogNThread; // an invalid nThread is reported in the warnLog of learn, learnSweep and predict
+		nThread_ = effectiveNThread(readAlgoCount(algo, "nThread", nThreadDefault, nThreadMax, warnLogNThread));
 #ifdef MC_VERBOSE
-		std::cout << "MixtureComposer::MixtureComposer, nInd: " << nInd_ << ", nClass: " << nClass_ << std::endl;
+		std::cout << "MixtureComposer::MixtureComposer, nInd: " << nInd_ << ", nClass: " << nClass_ << ", nThread: " << nThread_ << std::endl;
 #endif
 		zClassInd_.setIndClass(nInd_, nClass_);
 
@@ -79,13 +90,23 @@ public:
 		return nVar_;
 	}
 
+	/** @return number of threads used in the parallel loops */
+	Index nbThread() const {
+		return nThread_;
+	}
+
+	/** Change the number of threads used in the parallel loops, for example to share the threads between several composers */
+	void setNbThread(Index nThread) {
+		nThread_ = nThread;
+	}
+
 	/** @return  the zi class label */
 	const Vector<Index>* p_zi() const {
 		return &(zClassInd_.zi().data_);
 	}
 
 	/** @return  the zi class label */
-	const Vector<std::set<Index> >& classInd() const {
+	const Vector<std::vector<Index>>& classInd() const {
 		return zClassInd_.classInd();
 	}
 
@@ -95,10 +116,15 @@ public:
 	}
 
 	/** Compute the proportions and the model parameters given the current tik
-	 *  mixture parameters.
+	 *  mixture parameters. The shared parts are estimated in parallel over the variables, then the (variable, class)
+	 *  units are scheduled dynamically over the threads, most expensive first according to IMixture::mStepCost.
 	 *  @param[out] worstDeg worst degeneracy type encountered among all mixtures for this mStep
+	 *  @param movedInd individuals whose class may have changed since the previous mStep on the partition of z, or
+	 *  nullptr if classInd is not the partition of z, see IMixture::mStepShared
 	 **/
-	std::string mStep(const Vector<std::set<Index>>& classInd);
+	std::string mStep(const Vector<std::vector<Index>>& classInd, const std::vector<Index>* movedInd = nullptr);
+
+	/** mStep on the partition of z, the moves recorded by zClassInd_ are passed to the mixtures then cleared. */
 	std::string mStep();
 
 	/** Compute proportions using the ML estimator, default implementation. Set
@@ -127,6 +153,22 @@ public:
 	 **/
 	Real lnCompletedProbability(int i, int k) const;
 
+	/**
+	 * Completed log probabilities of the individuals iBegin to iEnd - 1 in every class, as the sum of the blocks of
+	 * each variable, see IMixture::lnCompletedProbabilityBlock.
+	 * @param[out] lnComp (iEnd - iBegin) x nClass matrix, row c corresponds to individual iBegin + c
+	 **/
+	void lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnComp) const;
+
+	/**
+	 * Same as lnCompletedProbabilityBlock, except that the contributions of the cached variables are read from
+	 * completedVarCache_, after the refresh of their stale parts. setCompletedCacheMode must have been called before.
+	 **/
+	void lnCompletedProbabilityBlockCached(Index iBegin, Index iEnd, Matrix<Real>& lnComp);
+
+	/** Query each variable for its stale completed probabilities, see IMixture::staleCompletedProbability, and set completedCacheMode_ accordingly. */
+	void setCompletedCacheMode();
+
 	Real lnObservedProbability(int i, int k) const;
 
 	/** @return the value of the observed likelihood */
@@ -135,6 +177,12 @@ public:
 	/** @return the value of the completed likelihood */
 	Real lnCompletedLikelihood() const;
 
+	/** @return the BIC criterion, computed from the observed likelihood. The higher the better. */
+	Real BIC() const;
+
+	/** @return the ICL criterion, computed from the completed likelihood. The higher the better. */
+	Real ICL() const;
+
 	/** write the parameters of the model in the stream os. */
 	void writeParameters() const;
 
@@ -157,14 +205,14 @@ public:
 	 * log is required.
 	 * @param[out] warnLog provides information on what condition has not been met
 	 * */
-	std::string checkSampleCondition(const Vector<std::set<Index>>& classInd) const;
+	std::string checkSampleCondition(const Vector<std::vector<Index>>& classInd) const;
 	std::string checkSampleCondition() const;
 
 	/**
 	 * Check if there are enough individual in each class. Called by checkSampleCondition.
 	 * @param[out] warnLog provides information on what condition has not been met
 	 * */
-	std::string checkNbIndPerClass(const Vector<std::set<Index>>& classInd) const;
+	std::string checkNbIndPerClass(const Vector<std::vector<Index>>& classInd) const;
 	std::string checkNbIndPerClass() const;
 
 	/**@brief This step can be used to signal to the mixtures that they must
@@ -187,16 +235,59 @@ public:
 	std::string setDataParam(RunMode mode, const Graph& data, const Graph& param, const Graph& desc) {
 		std::string warnLog;
 
-		for (ConstMixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it) {
-#ifdef MC_VERBOSE
-			std::cout << "MixtureComposer::setDataParam, " << (*it)->idName() << " started..." << std::endl;
-#endif
-			warnLog += (*it)->setDataParam(mode);
-#ifdef MC_VERBOSE
-			std::cout << "... finished." << std::endl;
-#endif
+		warnLog += setVariableDataParam(mode, nullptr, GraphConcurrentRead<Graph>::value ? nThread_ : 1); // the columns are parsed concurrently only if the Graph allows it
+
+		warnLog += setLatentDataParam(mode, data, param, desc);
+
+		return warnLog;
+	}
+
+	/**
+	 * Same as setDataParam, except that the data of each variable is copied from source instead of being read and
+	 * parsed from the data Graph. source must have been built by createAllMixtures on the same desc, and setDataParam
+	 * must have succeeded on it. Its number of classes can be different. The class labels are still read from data,
+	 * as their validity depends on the number of classes.
+	 */
+	template<typename Graph>
+	std::string setDataParam(RunMode mode, const MixtureComposer& source, const Graph& data, const Graph& param, const Graph& desc) {
+		std::string warnLog;
+
+		if (source.nVar_ != nVar_) {
+			return "MixtureComposer::setDataParam, the source composer has a different number of variables. This is a bug, please contact the maintainer." + eol;
+		}
+
+		for (Index v = 0; v < nVar_; ++v) {
+			if (source.v_mixtures_[v]->idName() != v_mixtures_[v]->idName() || source.v_mixtures_[v]->modelType() != v_mixtures_[v]->modelType()) {
+				return "MixtureComposer::setDataParam, variable " + v_mixtures_[v]->idName() + " does not match the variable of the source composer. This is a bug, please contact the maintainer." + eol;
+			}
 		}
 
+		warnLog += setVariableDataParam(mode, &source, nThread_); // the Graph is not accessed
+
+		warnLog += setLatentDataParam(mode, data, param, desc);
+
+		return warnLog;
+	}
+
+	/**
+	 * First part of setDataParam, call setDataParam on every variable. Nothing is shared between the variables, hence
+	 * they are processed concurrently on nThread threads. The warnings are concatenated in the order of the variables, and
+	 * if some variables throw, the exception of the first one is rethrown once all variables have been processed, so that
+	 * the result does not depend on the number of threads. The time spent on each variable is stored in readTime_.
+	 *
+	 * @param p_source if not nullptr, the data is copied from the variables of p_source, otherwise it is read from the data
+	 * Graph
+	 */
+	std::string setVariableDataParam(RunMode mode, const MixtureComposer* p_source, Index nThread);
+
+	/** Time spent in setDataParam by each variable, in seconds, in the order of the variables. */
+	NamedVector<Real> readTime() const;
+
+	/** Set the class labels, and in prediction the proportions. Second part of setDataParam, once the variables have been set. */
+	template<typename Graph>
+	std::string setLatentDataParam(RunMode mode, const Graph& data, const Graph& param, const Graph& desc) {
+		std::string warnLog;
+
 		warnLog += setZi(data, desc); // dataHandler getData is called to fill zi_
 
 		if (mode == prediction_) { // in prediction, paramStatStorage_ will not be modified later during the run
@@ -320,8 +411,8 @@ public:
 		Real lnCompLik = lnCompletedLikelihood();
 		g.add_payload( { "mixture" }, "lnObservedLikelihood", lnObsLik);
 		g.add_payload( { "mixture" }, "lnCompletedLikelihood", lnCompLik);
-		g.add_payload( { "mixture" }, "BIC", lnObsLik - 0.5 * nFreeParameters * std::log(nInd_));
-		g.add_payload( { "mixture" }, "ICL", lnCompLik - 0.5 * nFreeParameters * std::log(nInd_));
+		g.add_payload( { "mixture" }, "BIC", BIC());
+		g.add_payload( { "mixture" }, "ICL", ICL());
 
 #ifdef MC_VERBOSE
 		std::cout << "lnObservedLikelihood: " << lnObsLik << std::endl << std::endl;
@@ -426,7 +517,14 @@ public:
 	 * when individuals have not been completed using the real model.
 	 */
 	std::string eStepObserved();
-	bool eStepObservedInd(Index i);
+
+	/**
+	 * eStepObserved on the individuals iBegin to iEnd - 1, the t_ik of the block are normalized at once.
+	 *
+	 * @param[out] isIndividualObservable set to false for the individuals of the block whose observed probability is 0 in
+	 * every class
+	 */
+	void eStepObservedBlock(Index iBegin, Index iEnd, std::vector<char>& isIndividualObservable);
 
 	/** Call initializeMarkovChain on all variables. */
 	void initializeMarkovChain();
@@ -457,6 +555,9 @@ private:
 	/** Number of variables */
 	Index nVar_;
 
+	/** Number of threads used in the parallel loops, read from the optional nThread field of algo */
+	Index nThread_;
+
 	/** confidence level used for the computation of statistics */
 	Real confidenceLevel_;
 
@@ -482,15 +583,33 @@ private:
 	ClassDataStat dataStat_;
 
 	/**
-	 * Cached observed log probability. The access is done via:
-	 * observedProbabilityCache_(variable)(individual, class) to more or less match the t_ik access
-	 * pattern.
+	 * Cached observed log probability, in a single allocation. The access is done via:
+	 * observedProbabilityCache_(class, variable * nInd_ + individual), so that the classes of an individual in a
+	 * variable are contiguous, to match the t_ik access pattern.
 	 * */
-	Vector<Matrix<Real> > observedProbabilityCache_;
+	Matrix<Real> observedProbabilityCache_;
 
 	/** Cached completed log probability for each individual, can be used to export the evolution of the completed likelihood of the data, iteration after iteration. */
 	Vector<Real> completedProbabilityCache_;
 
+	/** How the completed log probabilities of a variable are obtained at the current E step */
+	enum CompletedCacheMode {
+		notCached_, // the variable is computed directly, without cache
+		refreshAll_, // the whole cache of the variable is recomputed
+		refreshStale_ // only the stale individuals of the cache are recomputed
+	};
+
+	/**
+	 * Contribution of each variable to the completed log probability, nInd_ x nClass_, for the variables that support
+	 * dirty tracking. The matrix of the other variables is empty.
+	 */
+	std::vector<Matrix<Real>> completedVarCache_;
+
+	/** Stale individuals of each variable at the current E step */
+	std::vector<std::vector<Index>> staleInd_;
+
+	std::vector<CompletedCacheMode> completedCacheMode_;
+
 	Index initialNIter_;
 
 	/** Cached completed log probability for each individual, can be used to export the evolution of the completed likelihood of the data, iteration after iteration. */
@@ -504,6 +623,15 @@ private:
 
 	/** Stable iterations */
 	Index nConsecutiveStableIterations_;
+
+	/** Time spent in setDataParam by each variable, see setVariableDataParam */
+	Vector<Real> readTime_;
+
+	/** Key of all the random streams opened by the composer */
+	std::uint64_t rngSeed_;
+
+	/** Incremented each time a loop opens random streams, so that two loops never draw from the same stream */
+	Index rngEpoch_;
 };
 
 } /* namespace mixt */
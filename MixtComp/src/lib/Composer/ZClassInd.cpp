@@ -30,6 +30,9 @@ void ZClassInd::setIndClass(Index nbInd, Index nbClass) {
 	nbClass_ = nbClass;
 	zi_.resizeArrays(nbInd);
 	classInd_.resize(nbClass);
+	moved_.resize(nbInd);
+	moved_ = notMoved_;
+	movedInd_.clear();
 }
 
 void ZClassInd::computeRange() {
@@ -58,19 +61,18 @@ std::string ZClassInd::setZi(std::vector<std::string>& data) {
 	std::string warnLog;
 	warnLog += StringToAugmentedData("z_class", data, zi_, -minModality);
 
-	for (int k = 0; k < nbClass_; ++k) {
-		classInd_(k).clear();
-	}
-
 	computeRange();
 
 	warnLog += checkRange();
 
 	if(warnLog.size() == 0)
 	{
-		for (int i = 0; i < nbInd_; ++i) {
-			classInd_(zi_.data_(i)).insert(i);
+		for (Index i = 0; i < nbInd_; ++i) { // every individual has been written without setZ
+			if (moved_(i) == notMoved_) {
+				moved_(i) = movedNotListed_;
+			}
 		}
+		computeClassInd();
 	}
 	return warnLog;
 }
@@ -98,13 +100,26 @@ std::string ZClassInd::checkMissingType() {
 	return zi_.checkMissingType(at);
 }
 
-void ZClassInd::setZAndClassInd(Index i, Index k) {
-#pragma omp critical(setZAndClassInd)
-	{
-		classInd_(zi_.data_(i)).erase(i);
-		classInd_(k).insert(i);
+void ZClassInd::computeClassInd() {
+	for (Index k = 0; k < nbClass_; ++k) {
+		classInd_(k).clear();
+	}
+
+	for (Index i = 0; i < nbInd_; ++i) {
+		classInd_(zi_.data_(i)).push_back(i);
+
+		if (moved_(i) == movedNotListed_) {
+			movedInd_.push_back(i);
+			moved_(i) = movedListed_;
+		}
+	}
+}
+
+void ZClassInd::clearMovedInd() {
+	for (std::vector<Index>::const_iterator it = movedInd_.begin(), itEnd = movedInd_.end(); it != itEnd; ++it) {
+		moved_(*it) = notMoved_;
 	}
-	zi_.data_(i) = k;
+	movedInd_.clear();
 }
 
 void ZClassInd::printState() const {
@@ -113,7 +128,7 @@ void ZClassInd::printState() const {
 
 	for (Index k = 0; k < nbClass_; ++k) {
 		std::cout << "k = " << k << ":";
-		for (std::set<Index>::const_iterator it = classInd_(k).begin(), itEnd = classInd_(k).end(); it != itEnd; ++it) {
+		for (std::vector<Index>::const_iterator it = classInd_(k).begin(), itEnd = classInd_(k).end(); it != itEnd; ++it) {
 			std::cout << " " << *it;
 		}
 		std::cout << std::endl;
@@ -25,7 +25,7 @@
 #define LIB_COMPOSER_ZCLASSIND_H
 
 #include <Data/AugmentedData.h>
-#include <set>
+#include <vector>
 #include <regex>
 #include <IO/IOFunctions.h>
 
@@ -66,13 +66,34 @@ public:
 	/** The DataHandler initializes zi_, and classInd_ is updated. */
 	std::string setZi(std::vector<std::string>& data);
 
-	/** The class of a particular individual is modified */
-	void setZAndClassInd(Index i, Index k);
+	/** The class of a particular individual is modified. Only zi_ and moved_ are written, without lock or allocation, so
+	 * that individuals can be processed in parallel. computeClassInd must be called once all individuals have been
+	 * processed. */
+	void setZ(Index i, Index k) {
+		if (zi_.data_(i) != k && moved_(i) == notMoved_) {
+			moved_(i) = movedNotListed_;
+		}
+		zi_.data_(i) = k;
+	}
+
+	/** Rebuild classInd_ from zi_ in a single pass. The capacity of each class array is kept between calls, hence
+	 * there is no allocation once the class sizes have stabilized. The individuals that moved since the previous call
+	 * are appended to movedInd_ in the same pass. */
+	void computeClassInd();
+
+	/** Individuals whose class has been modified since the last call of clearMovedInd, each listed once, in no
+	 * particular order. Some may since have moved back to their former class. */
+	const std::vector<Index>& movedInd() const {
+		return movedInd_;
+	}
+
+	/** Empty movedInd_, in O(movedInd_.size()). */
+	void clearMovedInd();
 
 	const AugmentedData<Vector<Index> >& zi() const {
 		return zi_;
 	}
-	const Vector<std::set<Index> >& classInd() const {
+	const Vector<std::vector<Index>>& classInd() const {
 		return classInd_;
 	}
 
@@ -86,8 +107,18 @@ private:
 	AugmentedData<Vector<Index> > zi_;
 
 	/** A vector containing in each element a vector of the indices of individuals that
-	 * belong to this class. Can be passed as an alternative to zi_ to a subtype of IMixture. */
-	Vector<std::set<Index> > classInd_;
+	 * belong to this class, in increasing order. Can be passed as an alternative to zi_ to a subtype of IMixture. */
+	Vector<std::vector<Index>> classInd_;
+
+	enum MovedState {
+		notMoved_, movedNotListed_, movedListed_
+	};
+
+	/** State of each individual with respect to movedInd_ */
+	Vector<MovedState> moved_;
+
+	/** Individuals that moved since the last call of clearMovedInd, see movedInd() */
+	std::vector<Index> movedInd_;
 };
 
 } /* namespace mixt */
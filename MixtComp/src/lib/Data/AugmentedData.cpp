@@ -127,7 +127,7 @@ void AugmentedData<Vector<int> >::removeMissingSample(Index i) {
 			Real proba = 1. / misData_(i).second.size(); // (iterator on map)->(mapped element).(vector of parameters)
 			Vector<Real> modalities(nbModalities);
 			modalities = 0.;
-			for (std::vector<int>::const_iterator itParam = misData_(i).second.begin(); itParam != misData_(i).second.end(); ++itParam) {
+			for (const int* itParam = misData_(i).second.begin(), *itEnd = misData_(i).second.end(); itParam != itEnd; ++itParam) {
 				modalities[*itParam] = proba;
 			}
 			sampleVal = multi_.sample(modalities);
@@ -195,7 +195,7 @@ void AugmentedData<Vector<std::size_t> >::removeMissingSample(Index i) {
 			Real proba = 1. / misData_(i).second.size(); // (iterator on map)->(mapped element).(vector of parameters)
 			Vector<Real> modalities(nbModalities);
 			modalities = 0.;
-			for (std::vector<std::size_t>::const_iterator itParam = misData_(i).second.begin(); itParam != misData_(i).second.end(); ++itParam) {
+			for (const std::size_t* itParam = misData_(i).second.begin(), *itEnd = misData_(i).second.end(); itParam != itEnd; ++itParam) {
 				modalities[*itParam] = proba;
 			}
 			sampleVal = multi_.sample(modalities);
@@ -28,6 +28,7 @@
 #include <utility>
 #include <vector>
 
+#include <Data/MisDataTable.h>
 #include <Statistic/MultinomialStatistic.h>
 #include <Statistic/UniformStatistic.h>
 #include <Statistic/UniformIntStatistic.h>
@@ -150,7 +151,8 @@ public:
 				 * carried on.
 				 */
 			default: {
-				for (typename std::vector<Type>::const_iterator it = misData_(i).second.begin(); it != misData_(i).second.end(); ++it) {
+				typename MisDataTable<Type>::Param param = misData_(i).second;
+				for (typename MisDataTable<Type>::Param::const_iterator it = param.begin(); it != param.end(); ++it) {
 					rangeUpdate(min, max, *it, dataRangeUpdate);
 				}
 			}
@@ -164,14 +166,14 @@ public:
 
 	void setPresent(int i, Type val) {
 		data_(i) = val;
-		misData_(i) = MisVal(present_, std::vector<Type>());
+		misData_.set(i, MisVal(present_, std::vector<Type>()));
 		++misCount_(present_);
 		++nbSample_;
 	}
 
 	void setMissing(int i, const MisVal& val) {
 		data_(i) = std::numeric_limits<int>::quiet_NaN(); // set to quiet nan, for types that supports it. For int, the returned value would be 0 ...
-		misData_(i) = val;
+		misData_.set(i, val);
 		++misCount_(val.first);
 		++nbSample_;
 	}
@@ -192,8 +194,8 @@ public:
 	/** Completed data, usually a Vector, for example Vector<Index> or Vector<Real> */
 	DataType data_;
 
-	/** data structure for partially observed values */
-	Vector<MisVal> misData_;
+	/** data structure for partially observed values, misData_(i) has the members of a MisVal */
+	MisDataTable<Type> misData_;
 
 	/** total number of values */
 	int nbSample_;
@@ -23,44 +23,104 @@
 #ifndef CONFINTDATASTAT_H
 #define CONFINTDATASTAT_H
 
+#include <algorithm>
+
 #include <Data/AugmentedData.h>
 #include <LinAlg/LinAlg.h>
+#include <Various/Constants.h>
+#include <Various/Enum.h>
 
 namespace mixt {
 
+/**
+ * Read the optional dataStat field of algo: "exact" (default) or "reservoir".
+ *
+ * @param[out] mode mode read, exactDataStat_ if the field is absent or invalid
+ * @return empty string if no errors, otherwise errors description
+ */
+template<typename Graph>
+std::string dataStatMode(const Graph& algo, DataStatMode& mode) {
+	mode = exactDataStat_;
+
+	if (!algo.exist_payload( { }, "dataStat")) {
+		return "";
+	}
+
+	std::string modeStr = algo.template get_payload<std::string>( { }, "dataStat");
+	if (modeStr == "reservoir") {
+		mode = reservoirDataStat_;
+	} else if (modeStr != "exact") {
+		return "dataStat in algo must be either \"exact\" or \"reservoir\", not \"" + modeStr + "\"." + eol;
+	}
+
+	return "";
+}
+
+/**
+ * Median and confidence interval of the values sampled for the missing data during the Gibbs run phase.
+ *
+ * The sampled values of all the partially observed individuals are stored in a single arena, one column per individual.
+ * In exactDataStat_ mode a column has one row per iteration. In reservoirDataStat_ mode a column has at most
+ * nDataStatReservoir rows: once it is full, every other stored value is discarded and only one iteration out of two is
+ * stored from then on, hence the reservoir is a systematic subsample of the whole run. The thinning only depends on the
+ * iteration number, so that no random draw is used and the results do not depend on the order of the individuals.
+ *
+ * The arena only exists during the Gibbs run phase: it is allocated by beginGibbsRun, before the first call to
+ * sampleVals, and freed by endGibbsRun, once the statistics of every individual have been exported. The calls to
+ * sampleVals can then be made in any order of the individuals.
+ */
 template<typename Type>
 class ConfIntDataStat {
 public:
-	ConfIntDataStat(AugmentedData<Vector<Type> >& augData, Real confidenceLevel) :
-			augData_(augData), confidenceLevel_(confidenceLevel) {
+	ConfIntDataStat(AugmentedData<Vector<Type> >& augData, Real confidenceLevel, DataStatMode mode = exactDataStat_) :
+			augData_(augData), confidenceLevel_(confidenceLevel), mode_(mode), nSlot_(0), capacity_(0) {
 	}
 	;
 
 	void setNbIndividual(int nbInd) {
-		stat_.resize(nbInd);
 		dataStatStorage_.resize(nbInd);
+		slot_.resize(nbInd);
+
+		nSlot_ = 0;
+		for (int ind = 0; ind < nbInd; ++ind) {
+			slot_(ind) = (augData_.misData_(ind).first != present_) ? nSlot_++ : nbInd;
+		}
+	}
+
+	/** Allocate the arena for a Gibbs run phase of iterationMax + 1 iterations */
+	void beginGibbsRun(Index iterationMax) {
+		capacity_ = (mode_ == exactDataStat_) ? iterationMax + 1 : std::min(iterationMax + 1, nDataStatReservoir);
+		stat_.resize(capacity_, nSlot_);
+	}
+
+	/** Free the arena, once the statistics of every individual have been exported */
+	void endGibbsRun() {
+		stat_.resize(0, 0);
 	}
 
 	void sampleVals(int ind, int iteration, int iterationMax) {
 		if (augData_.misData_(ind).first != present_) {
-			if (iteration == 0) { // clear the temporary statistical object
-				stat_(ind).resize(iterationMax + 1); // temporary storage for the individual
+			Index slot = slot_(ind);
+
+			if (iteration == 0) {
 				dataStatStorage_(ind).resize(3); // export storage
 
 				sample(ind, iteration); // first sampling
 			} else if (iteration == iterationMax) { // export the statistics to the p_dataStatStorage object
 				sample(ind, iteration); // last sampling
 
-				stat_(ind).sort();
-				Real alpha = (1. - confidenceLevel_) / 2.;
-				int realIndLow = alpha * iterationMax;
-				int realIndHigh = (1. - alpha) * iterationMax;
+				int nStored = iteration / stride(iteration) + 1;
+				int lastStored = nStored - 1; // plays the role of iterationMax in the exact case
+				Type* first = stat_.data() + slot * capacity_;
+				std::sort(first, first + nStored);
 
-				dataStatStorage_(ind)(0) = stat_(ind)(iterationMax / 2);
-				dataStatStorage_(ind)(1) = stat_(ind)(realIndLow);
-				dataStatStorage_(ind)(2) = stat_(ind)(realIndHigh + 1);
+				Real alpha = (1. - confidenceLevel_) / 2.;
+				int realIndLow = alpha * lastStored;
+				int realIndHigh = (1. - alpha) * lastStored;
 
-				stat_(ind).resize(0); // clear the memory for current individual
+				dataStatStorage_(ind)(0) = first[lastStored / 2];
+				dataStatStorage_(ind)(1) = first[realIndLow];
+				dataStatStorage_(ind)(2) = first[realIndHigh + 1];
 			} else {
 				sample(ind, iteration); // standard sampling
 			}
@@ -78,8 +138,28 @@ public:
 	}
 
 private:
-	void sample(int ind, int iteration) {
-		stat_(ind)(iteration) = augData_.data_(ind);
+	/** Number of iterations between two stored values, at a given iteration. It is always 1 in exactDataStat_ mode. */
+	Index stride(Index iteration) const {
+		Index s = 1;
+		while (capacity_ <= iteration / s) {
+			s *= 2;
+		}
+		return s;
+	}
+
+	void sample(int ind, Index iteration) {
+		Type* col = stat_.data() + slot_(ind) * capacity_;
+		Index s = stride(iteration);
+
+		if (0 < iteration && stride(iteration - 1) < s) { // the reservoir is full, one value out of two is kept
+			for (Index r = 0; 2 * r < capacity_; ++r) {
+				col[r] = col[2 * r];
+			}
+		}
+
+		if (iteration % s == 0) {
+			col[iteration / s] = augData_.data_(ind);
+		}
 	}
 
 	/** pointer to data array */
@@ -88,12 +168,24 @@ private:
 	/** Description of the missing values */
 	Vector<RowVector<Type> > dataStatStorage_;
 
-	/** Array to store sampled values across iterations, for the current individual, access: tempStat_[i]
-	 * i: iteration */
-	Vector<Vector<Type> > stat_;
+	/** Arena of the values sampled across iterations, access: stat_(r, s)
+	 * r: stored iteration
+	 * s: slot of the partially observed individual */
+	Matrix<Type> stat_;
 
 	/** Confidence level */
 	Real confidenceLevel_;
+
+	DataStatMode mode_;
+
+	/** Slot of each individual in the arena, the number of individuals for the fully observed ones */
+	Vector<Index> slot_;
+
+	/** Number of partially observed individuals */
+	Index nSlot_;
+
+	/** Number of rows of the arena */
+	Index capacity_;
 };
 
 } // namespace mixt
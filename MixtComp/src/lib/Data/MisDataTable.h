@@ -0,0 +1,182 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+
+#ifndef LIB_DATA_MISDATATABLE_H
+#define LIB_DATA_MISDATATABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <LinAlg/LinAlg.h>
+#include <Various/Enum.h>
+
+namespace mixt {
+
+/**
+ * Description of the missing values of a variable, one entry per individual, which can be read as a
+ * std::pair<MisType, std::vector<Type> > through operator(): misData(i).first is the type of missing value, and
+ * misData(i).second the list of its parameters, for example the bounds of an interval or the allowed modalities.
+ *
+ * Most values are present in real datasets, and completely missing values have no parameters either. Hence the types are
+ * stored in a dense array of one byte per individual, and only the entries with parameters are stored in a sparse side
+ * table, sorted by individual, with the parameters of all entries packed in a single array (CSR layout). Reading the type
+ * is a direct access, reading the parameters is a binary search on the side table.
+ */
+template<typename Type>
+class MisDataTable {
+public:
+	typedef std::pair<MisType, std::vector<Type> > MisVal;
+
+	/** Read-only view on the parameters of an entry, valid until the table is modified. */
+	class Param {
+	public:
+		typedef const Type* const_iterator;
+
+		Param() :
+				begin_(nullptr), end_(nullptr) {
+		}
+
+		Param(const_iterator begin, const_iterator end) :
+				begin_(begin), end_(end) {
+		}
+
+		const_iterator begin() const {
+			return begin_;
+		}
+
+		const_iterator end() const {
+			return end_;
+		}
+
+		Index size() const {
+			return end_ - begin_;
+		}
+
+		const Type& operator[](Index p) const {
+			return begin_[p];
+		}
+
+	private:
+		const_iterator begin_;
+		const_iterator end_;
+	};
+
+	/** Entry of the table, with the same members as MisVal */
+	struct Entry {
+		MisType first;
+		Param second;
+	};
+
+	MisDataTable() {
+		offset_.push_back(0);
+	}
+
+	/** Resize the table, every entry is reset to present_. */
+	void resize(Index n) {
+		type_.assign(n, present_);
+		ind_.clear();
+		offset_.assign(1, 0);
+		param_.clear();
+	}
+
+	Index size() const {
+		return type_.size();
+	}
+
+	Index rows() const {
+		return type_.size();
+	}
+
+	Entry operator()(Index i) const {
+		Entry e;
+		e.first = MisType(type_[i]);
+
+		if (e.first != present_ && e.first != missing_) {
+			Index s = std::lower_bound(ind_.begin(), ind_.end(), i) - ind_.begin();
+			if (s < ind_.size() && ind_[s] == i) {
+				e.second = Param(param_.data() + offset_[s], param_.data() + offset_[s + 1]);
+			}
+		}
+
+		return e;
+	}
+
+	/** Number of entries which have parameters */
+	Index nParamEntry() const {
+		return ind_.size();
+	}
+
+	void set(Index i, const MisVal& mv) {
+		type_[i] = mv.first;
+
+		Index s = (ind_.size() == 0 || ind_.back() < i) ? ind_.size() : std::lower_bound(ind_.begin(), ind_.end(), i) - ind_.begin();
+		bool stored = s < ind_.size() && ind_[s] == i;
+
+		if (stored) { // the previous parameters are removed, this only happens if an entry is set twice
+			Index nOld = offset_[s + 1] - offset_[s];
+			param_.erase(param_.begin() + offset_[s], param_.begin() + offset_[s + 1]);
+			ind_.erase(ind_.begin() + s);
+			offset_.erase(offset_.begin() + s + 1);
+			for (Index t = s + 1; t < offset_.size(); ++t) {
+				offset_[t] -= nOld;
+			}
+		}
+
+		if (mv.first == present_ || mv.first == missing_ || mv.second.size() == 0) {
+			return;
+		}
+
+		Index nNew = mv.second.size();
+		if (s == ind_.size()) { // entries are usually set in increasing order, hence appended
+			ind_.push_back(i);
+			param_.insert(param_.end(), mv.second.begin(), mv.second.end());
+			offset_.push_back(param_.size());
+		} else {
+			ind_.insert(ind_.begin() + s, i);
+			param_.insert(param_.begin() + offset_[s], mv.second.begin(), mv.second.end());
+			offset_.insert(offset_.begin() + s + 1, offset_[s] + nNew);
+			for (Index t = s + 2; t < offset_.size(); ++t) {
+				offset_[t] += nNew;
+			}
+		}
+	}
+
+	/** Release the memory reserved in excess during the filling of the table. */
+	void shrink() {
+		ind_.shrink_to_fit();
+		offset_.shrink_to_fit();
+		param_.shrink_to_fit();
+	}
+
+private:
+	/** Type of each entry, stored as a MisType */
+	std::vector<std::uint8_t> type_;
+
+	/** Sorted indices of the entries that have parameters */
+	std::vector<Index> ind_;
+
+	/** The parameters of the entry ind_[s] are param_[offset_[s]] to param_[offset_[s + 1] - 1] */
+	std::vector<Index> offset_;
+
+	std::vector<Type> param_;
+};
+
+} // namespace mixt
+
+#endif /* LIB_DATA_MISDATATABLE_H */
@@ -25,18 +25,89 @@
 
 #include <Data/AugmentedData.h>
 #include <LinAlg/LinAlg.h>
+#include <cmath>
+#include <limits>
 #include <string>
+#include <type_traits>
 #include <vector>
+#include <Various/Enum.h>
 
 #include "MisValParser.h"
 
 namespace mixt {
 
+/**
+ * Type in which a simple mixture reads its column of data from a Graph, with get_payload. The default is a copy in a
+ * std::vector<std::string>, in which every cell is parsed by MisValParser. A Graph can specialize it, for example with
+ * a read-only view on its own storage, or with a MixedColumn to accept native numeric columns. The type must then
+ * provide:
+ * - Index size() const
+ * - CellType cellType(Index i) const
+ * - Real number(Index i) const, value of a numberCell_
+ * - operator[](Index i) const, returning the string of a stringCell_ (by value or by reference)
+ */
+template<typename Graph>
+struct DataColumn {
+	typedef std::vector<std::string> Type;
+};
+
+template<typename Column>
+CellType cellType(const Column& data, Index i) {
+	return data.cellType(i);
+}
+
+template<typename Column>
+Real cellNumber(const Column& data, Index i) {
+	return data.number(i);
+}
+
+/** A column of strings only contains strings. */
+inline CellType cellType(const std::vector<std::string>&, Index) {
+	return stringCell_;
+}
+
+inline Real cellNumber(const std::vector<std::string>&, Index) {
+	return 0.;
+}
+
+/**
+ * Conversion of a number of a numeric column to the data type of a model. The values of integer types are truncated,
+ * as str2type does on a string.
+ *
+ * @return false if the number can not be represented, for example if it is not finite
+ */
+template<typename Type>
+bool numberToType(Real x, Type& val) {
+	if (!std::isfinite(x)) {
+		return false;
+	}
+
+	if (std::is_integral<Type>::value && (x <= Real(std::numeric_limits<Type>::min()) - 1. || Real(std::numeric_limits<Type>::max()) + 1. <= x)) {
+		return false;
+	}
+
+	val = static_cast<Type>(x);
+	return true;
+}
+
+/**
+ * Whether several threads can read a Graph at the same time, with its const methods. If so, MixtureComposer parses the
+ * variables concurrently. This is false by default, as the R and Python objects wrapped by their Graphs must only be
+ * accessed from the main thread.
+ */
+template<typename Graph>
+struct GraphConcurrentRead {
+	static const bool value = false;
+};
+
 /**
  * Equivalent to Datahandler::getData in old architecture.
+ *
+ * @param data column of data, a std::vector<std::string> or any DataColumn type. The numbers and the missing cells are
+ * set directly, only the strings are parsed.
  */
-template<typename DataType>
-std::string StringToAugmentedData(const std::string& idName, const std::vector<std::string>& data, AugmentedData<DataType>& augData, Index offset) {
+template<typename DataType, typename DataColumnType>
+std::string StringToAugmentedData(const std::string& idName, const DataColumnType& data, AugmentedData<DataType>& augData, Index offset) {
 	std::string warnLog;
 	typedef typename AugmentedData<DataType>::Type Type;
 	typedef typename AugmentedData<Matrix<Type> >::MisVal MisVal;
@@ -47,12 +118,31 @@ std::string StringToAugmentedData(const std::string& idName, const std::vector<s
 	augData.resizeArrays(nbInd); // R has already enforced that all data has the same number of rows, and now all mixture are univariate
 
 	for (Index i = 0; i < nbInd; ++i) {
-		std::string currStr;
+		CellType currType = cellType(data, i);
+
+		if (currType == missingCell_) {
+			augData.setMissing(i, MisVal(missing_, std::vector<Type>()));
+			continue;
+		}
+
+		if (currType == numberCell_) {
+			Real x = cellNumber(data, i);
+			Type val;
+
+			if (numberToType(x, val)) {
+				augData.setPresent(i, val + Type(offset));
+			} else {
+				std::stringstream sstm;
+				sstm << "In " << idName << ", individual i: " << i << " present an error. " << x << " is not recognized as a valid format." << std::endl;
+				warnLog += sstm.str();
+			}
+			continue;
+		}
+
+		const std::string& currStr = data[i];
 		Type val;
 		MisVal misVal;
 
-		currStr = data[i];
-
 		bool isValid = mvp.parseStr(currStr, val, misVal);
 		if (isValid) {
 			if (misVal.first == present_) {
@@ -68,6 +158,8 @@ std::string StringToAugmentedData(const std::string& idName, const std::vector<s
 			warnLog += sstm.str();
 		}
 	}
+
+	augData.misData_.shrink();
 	return warnLog;
 }
 
@@ -25,23 +25,32 @@
 
 #include <IO/IO.h>
 #include <IO/SpecialStr.h>
+#include <algorithm>
+#include <charconv>
 #include <iostream>
 #include <regex>
 #include <set>
+#include <system_error>
+#include <type_traits>
 
 #include <Various/Enum.h>
 
 namespace mixt {
 
+/**
+ * Reference implementation of the parser of the missing values, using regular expressions. It is slow, since up to seven
+ * regex_match are run on each string, and is only used when MixtComp is built with MC_REGEX_PARSER, to compare with
+ * MisValScanParser, or in case of a discrepancy between the two.
+ */
 template<typename Type>
-class MisValParser {
+class MisValRegexParser {
 public:
 	/** Missing value descriptor: type of missing, and list of parameters */
 	typedef typename std::pair<MisType, std::vector<Type> > MisVal;
 
 	/** Note that https://regex101.com/ REALLY helps settings those regular expressions.  Note that since raw strings are not used, and as such
 	 * escape characters have to be doubled, which impairs test on regex101 for example. */
-	MisValParser(Type offset) :
+	MisValRegexParser(Type offset) :
 			offset_(offset), reNumber_(strNumber), reValue_(strBlank + // " *(-*[0-9.]+) *"
 					strNumber + strBlank), reMissing_(strBlank + strQMark + strBlank), reFiniteValues_(" *\\{.*\\} *"), // enclosing {} are detected first, then the interior is parsed for the list of values. In the interior, any separator between the numbers will work
 			reIntervals_(strLeftPar + // " *\\[ *(-*[0-9.]+) *: *(-*[0-9.]+) *\\] *"
@@ -133,6 +142,249 @@ private:
 	std::regex reRuIntervals_;
 };
 
+/**
+ * Parser of the missing values, in a single pass on the characters of the string, without regex and without allocation
+ * for the present values. The accepted formats and the results are exactly those of MisValRegexParser:
+ * - value: " *NUM *"
+ * - missing: " *\? *"
+ * - finite values: " *\{.*\} *", where every number of the interior is a value, whatever the separators
+ * - intervals: " *\[ *NUM *: *NUM *\] *", " *\[ *-inf *: *NUM *\] *" and " *\[ *NUM *: *\+inf *\] *"
+ * with NUM defined by strNumber: an optional sign followed by digits and an optional decimal part, or a decimal point
+ * followed by digits, and an optional negative exponent.
+ */
+template<typename Type>
+class MisValScanParser {
+public:
+	/** Missing value descriptor: type of missing, and list of parameters */
+	typedef typename std::pair<MisType, std::vector<Type> > MisVal;
+
+	MisValScanParser(Type offset) :
+			offset_(offset) {
+	}
+
+	bool parseStr(const std::string& str, Type& v, MisVal& mv) const {
+		const char* first = str.data();
+		const char* last = first + str.size();
+
+		const char* p = skipBlank(first, last);
+		while (p != last && *(last - 1) == ' ') {
+			--last;
+		}
+
+		if (p == last) {
+			return false;
+		}
+
+		switch (*p) {
+		case '?': { // value is completely missing
+			if (p + 1 != last) {
+				return false;
+			}
+
+			v = Type(0);
+			mv.first = missing_;
+			return true;
+		}
+
+		case '{': { // only a finite number of values are acceptable
+			if (p + 1 == last || *(last - 1) != '}') {
+				return false;
+			}
+
+			for (const char* c = p + 1; c != last - 1; ++c) {
+				if (*c == '\n' || *c == '\r') { // not matched by the . of the regex
+					return false;
+				}
+			}
+
+			v = Type(0);
+
+			std::set<Type> setVal; // using a set allows for automatic sorting and duplicates deletion
+			const char* c = p + 1;
+			while (c != last - 1) {
+				const char* endNum = scanNumber(c, last - 1);
+				if (endNum == c) {
+					++c;
+				} else {
+					setVal.insert(toType(c, endNum) + offset_);
+					c = endNum;
+				}
+			}
+
+			mv.first = missingFiniteValues_;
+			for (typename std::set<Type>::const_iterator it = setVal.begin(), itEnd = setVal.end(); it != itEnd; ++it) {
+				mv.second.push_back(*it);
+			}
+
+			return true;
+		}
+
+		case '[': { // acceptable values provided by intervals, possibly unbounded
+			p = skipBlank(p + 1, last);
+
+			bool minusInf = startsWith(p, last, "-inf");
+			const char* endLower = minusInf ? p + 4 : scanNumber(p, last);
+			if (endLower == p) {
+				return false;
+			}
+			const char* beginLower = p;
+
+			p = skipBlank(endLower, last);
+			if (p == last || *p != ':') {
+				return false;
+			}
+			p = skipBlank(p + 1, last);
+
+			bool plusInf = startsWith(p, last, "+inf");
+			const char* endUpper = plusInf ? p + 4 : scanNumber(p, last);
+			if (endUpper == p) {
+				return false;
+			}
+			const char* beginUpper = p;
+
+			p = skipBlank(endUpper, last);
+			if (p == last || *p != ']' || p + 1 != last) {
+				return false;
+			}
+
+			if (minusInf && plusInf) {
+				return false;
+			}
+
+			v = Type(0);
+
+			if (minusInf) { // data is lower bounded
+				mv.first = missingLUIntervals_;
+				mv.second.push_back(toType(beginUpper, endUpper) + offset_);
+				return true;
+			}
+
+			if (plusInf) { // data is upper bounded
+				mv.first = missingRUIntervals_;
+				mv.second.push_back(toType(beginLower, endLower) + offset_);
+				return true;
+			}
+
+			Type lower = toType(beginLower, endLower) + offset_;
+			Type upper = toType(beginUpper, endUpper) + offset_;
+
+			if (lower == upper) {
+				return false;
+			}
+
+			mv.first = missingIntervals_;
+			mv.second.reserve(2);
+			mv.second.push_back(std::min(lower, upper));
+			mv.second.push_back(std::max(lower, upper));
+			return true;
+		}
+
+		default: { // value is present
+			if (scanNumber(p, last) != last) {
+				return false;
+			}
+
+			v = toType(p, last) + offset_;
+			mv.first = present_;
+			return true;
+		}
+		}
+	}
+
+private:
+	static const char* skipBlank(const char* p, const char* last) {
+		while (p != last && *p == ' ') {
+			++p;
+		}
+		return p;
+	}
+
+	static const char* skipDigits(const char* p, const char* last) {
+		while (p != last && '0' <= *p && *p <= '9') {
+			++p;
+		}
+		return p;
+	}
+
+	static bool startsWith(const char* p, const char* last, const char* word) {
+		for (; *word != '\0'; ++p, ++word) {
+			if (p == last || *p != *word) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Longest number in the sense of strNumber starting at p.
+	 *
+	 * @return end of the number, p if there is no number starting at p
+	 */
+	static const char* scanNumber(const char* p, const char* last) {
+		const char* c = p;
+
+		if (c != last && (*c == '-' || *c == '+')) {
+			++c;
+		}
+
+		const char* endDigits = skipDigits(c, last);
+		if (endDigits != c) { // digits, with an optional decimal part that can be empty
+			c = endDigits;
+			if (c != last && *c == '.') {
+				c = skipDigits(c + 1, last);
+			}
+		} else if (c == p && c != last && *c == '.' && skipDigits(c + 1, last) != c + 1) { // decimal point and digits, no sign allowed
+			c = skipDigits(c + 1, last);
+		} else {
+			return p;
+		}
+
+		if (c != last && (*c == 'e' || *c == 'E') && c + 1 != last && *(c + 1) == '-') { // only negative exponents are recognized
+			const char* endExp = skipDigits(c + 2, last);
+			if (endExp != c + 2) {
+				c = endExp;
+			}
+		}
+
+		return c;
+	}
+
+	/**
+	 * Conversion of a number to Type, with the same result as str2type. from_chars is used when it succeeds, otherwise,
+	 * for example in case of overflow, the conversion falls back to str2type. The standard libraries that do not provide
+	 * from_chars for floating point types (__cpp_lib_to_chars undefined) always use str2type for them.
+	 */
+	static Type toType(const char* first, const char* last) {
+#ifndef __cpp_lib_to_chars
+		if constexpr (!std::is_integral<Type>::value) {
+			return str2type<Type>(std::string(first, last));
+		} else
+#endif
+		{
+			const char* begin = (*first == '+') ? first + 1 : first; // from_chars does not accept a leading +
+			Type x;
+			std::from_chars_result res = std::from_chars(begin, last, x);
+
+			if (res.ec != std::errc()) {
+				return str2type<Type>(std::string(first, last));
+			}
+
+			return x;
+		}
+	}
+
+	Type offset_;
+};
+
+#ifdef MC_REGEX_PARSER
+template<typename Type>
+using MisValParser = MisValRegexParser<Type>;
+#else
+/** Parser used for the data of every model. The regex implementation can be selected by building with MC_REGEX_PARSER. */
+template<typename Type>
+using MisValParser = MisValScanParser<Type>;
+#endif
+
 } // namespace mixt
 
 #endif // MISVALPARSER_H
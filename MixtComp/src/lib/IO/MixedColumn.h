@@ -0,0 +1,89 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+#ifndef LIB_IO_MIXEDCOLUMN_H
+#define LIB_IO_MIXEDCOLUMN_H
+
+#include <string>
+#include <vector>
+
+#include <LinAlg/LinAlg.h>
+#include <Various/Enum.h>
+
+namespace mixt {
+
+/**
+ * Data column in which each cell is either a number, a missing value or a string, in the format of DataColumn (see
+ * IOFunctions.h). It is filled by the Graphs that can not provide a view on their own storage, for example from an R
+ * numeric vector or a Python list. Only the strings are stored as such, the numbers are kept as Real.
+ */
+class MixedColumn {
+public:
+	/** Resize the column, all the cells are missing. */
+	void resize(Index n) {
+		type_.assign(n, missingCell_);
+		number_.assign(n, 0.);
+		str_.clear();
+		strInd_.assign(n, 0);
+	}
+
+	void setNumber(Index i, Real x) {
+		type_[i] = numberCell_;
+		number_[i] = x;
+	}
+
+	void setMissing(Index i) {
+		type_[i] = missingCell_;
+	}
+
+	void setString(Index i, const std::string& s) {
+		type_[i] = stringCell_;
+		strInd_[i] = str_.size();
+		str_.push_back(s);
+	}
+
+	Index size() const {
+		return type_.size();
+	}
+
+	CellType cellType(Index i) const {
+		return type_[i];
+	}
+
+	/** Value of a numberCell_ */
+	Real number(Index i) const {
+		return number_[i];
+	}
+
+	/** Value of a stringCell_ */
+	const std::string& operator[](Index i) const {
+		return str_[strInd_[i]];
+	}
+
+private:
+	std::vector<CellType> type_;
+	std::vector<Real> number_;
+
+	/** Strings of the stringCell_, in the order in which they have been set */
+	std::vector<std::string> str_;
+
+	/** Index in str_ of each stringCell_ */
+	std::vector<Index> strInd_;
+};
+
+} // namespace mixt
+
+#endif /* LIB_IO_MIXEDCOLUMN_H */
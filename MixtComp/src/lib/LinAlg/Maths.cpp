@@ -24,6 +24,7 @@
 #include <Various/Constants.h>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 namespace mixt {
 
@@ -31,10 +32,52 @@ int fac(int n) {
 	return std::round(tgamma(n + 1));
 }
 
+namespace {
+
+/** Table of log(n!) for 0 <= n < logFacTableSize, the initialization of a function-local static is thread-safe. */
+const std::vector<Real>& logFacTable() {
+	static const std::vector<Real> table = []() {
+		std::vector<Real> t(logFacTableSize);
+		for (int n = 0; n < logFacTableSize; ++n) {
+			t[n] = lgamma(n + 1);
+		}
+		return t;
+	}();
+
+	return table;
+}
+
+}
+
 Real logFac(int n) {
+	if (0 <= n && n < logFacTableSize) {
+		return logFacTable()[n];
+	}
+
 	return lgamma(n + 1);
 }
 
+void logToMultiRows(Matrix<Real>& logProba, Vector<Real>& logNorm) {
+	typedef Eigen::Matrix<Real, Eigen::Dynamic, 1, Eigen::ColMajor, logToMultiChunk, 1> ChunkVector; // dynamic size, but storage on the stack
+
+	Index nRow = logProba.rows();
+	logNorm.resize(nRow);
+
+	for (Index iBegin = 0; iBegin < nRow; iBegin += logToMultiChunk) {
+		Index nChunk = std::min(Index(logToMultiChunk), nRow - iBegin);
+		auto chunk = logProba.middleRows(iBegin, nChunk);
+
+		ChunkVector max = chunk.rowwise().maxCoeff();
+		chunk.colwise() -= max;
+		chunk = chunk.array().exp().matrix();
+
+		ChunkVector sum = chunk.rowwise().sum();
+		chunk.array().colwise() /= sum.array();
+
+		logNorm.segment(iBegin, nChunk) = max.array() + sum.array().log();
+	}
+}
+
 bool realEqual(Real a, Real b) {
 	return (a == b || std::abs(a - b) < std::abs(std::min(a, b)) * std::numeric_limits<Real>::epsilon()); // Test 1: Very cheap, but can result in false negatives, Test 2: More expensive, but comprehensive
 }
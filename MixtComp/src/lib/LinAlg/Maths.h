@@ -34,6 +34,7 @@ namespace mixt {
 
 int fac(int n);
 
+/** log(n!), read in a table computed once for the small values of n, which are the most frequent in count data. */
 Real logFac(int n);
 
 /*
@@ -86,6 +87,20 @@ Real sumLog(const Type& vec) {
 	return std::log(vecP.sum()) + std::log(max);
 }
 
+/**
+ * Row-wise version of logToMulti over a whole matrix: each row of logProba contains log probabilities up to a constant,
+ * and is replaced in place by the normalized probabilities, while logNorm receives the log of the normalizing constant
+ * of each row. This is the t_ik computation of MixtureComposer.
+ *
+ * Rows are processed by chunks of logToMultiChunk, with the temporaries on the stack, so that there is no heap
+ * allocation apart from the resize of logNorm. Inside a chunk every operation runs along the columns, which are
+ * contiguous in memory, hence exp and the divisions are vectorized by Eigen.
+ *
+ * @param[in,out] logProba nRow x nCol, log probabilities on input, probabilities on output
+ * @param[out] logNorm nRow, log of the sum of the exponentials of each input row
+ */
+void logToMultiRows(Matrix<Real>& logProba, Vector<Real>& logNorm);
+
 /**
  * https://stackoverflow.com/questions/4010240/comparing-doubles
  */
@@ -41,13 +41,19 @@ template<typename Graph>
 std::string createAllMixtures(const Graph& algo, const Graph& desc, const Graph& data, const Graph& param, Graph& out, MixtureComposer& composer) {
 	std::string warnLog;
 
-	Index nClass = algo.template get_payload<Index>( { }, "nClass");
+	Index nClass = composer.nbClass();
 	Real confidenceLevel = algo.template get_payload<Real>( { }, "confidenceLevel");
 	Index nInd = algo.template get_payload<Index>( { }, "nInd");
 
 	if(nInd < 1)
 		warnLog += "The dataset is empty." + eol;
 
+	ParamStatMode paramStat;
+	warnLog += paramStatMode(algo, paramStat);
+
+	DataStatMode dataStat;
+	warnLog += dataStatMode(algo, dataStat);
+
 	std::list<std::string> varNames;
 	desc.name_payload( { }, varNames);
 #ifdef MC_VERBOSE
@@ -63,35 +69,35 @@ std::string createAllMixtures(const Graph& algo, const Graph& desc, const Graph&
 			IMixture* p_mixture = NULL;
 
 			if (idModel == "Multinomial") {
-				p_mixture = new SimpleMixture<Graph, Multinomial>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStr);
+				p_mixture = new SimpleMixture<Graph, Multinomial>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStat, dataStat, paramStr);
 			}
 
 			else if (idModel == "Gaussian") {
-				p_mixture = new SimpleMixture<Graph, Gaussian>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStr);
+				p_mixture = new SimpleMixture<Graph, Gaussian>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStat, dataStat, paramStr);
 			}
 
 			else if (idModel == "Poisson") {
-				p_mixture = new SimpleMixture<Graph, Poisson>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStr);
+				p_mixture = new SimpleMixture<Graph, Poisson>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStat, dataStat, paramStr);
 			}
 
 			else if (idModel == "Weibull") {
-				p_mixture = new SimpleMixture<Graph, Weibull>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStr);
+				p_mixture = new SimpleMixture<Graph, Weibull>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStat, dataStat, paramStr);
 			}
 
 			else if (idModel == "NegativeBinomial") {
-				p_mixture = new SimpleMixture<Graph, NegativeBinomial>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStr);
+				p_mixture = new SimpleMixture<Graph, NegativeBinomial>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStat, dataStat, paramStr);
 			}
 
 			if (idModel == "Func_CS") {
-				p_mixture = new FuncCSMixture<Graph>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStr);
+				p_mixture = new FuncCSMixture<Graph>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStat, paramStr);
 			}
 
 			if (idModel == "Func_SharedAlpha_CS") {
-				p_mixture = new FuncSharedAlphaCSMixture<Graph>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStr);
+				p_mixture = new FuncSharedAlphaCSMixture<Graph>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStat, paramStr);
 			}
 
 			if (idModel == "Rank_ISR") {
-				p_mixture = new RankISRMixture<Graph>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStr);
+				p_mixture = new RankISRMixture<Graph>(data, param, out, idName, nClass, nInd, confidenceLevel, paramStat, paramStr);
 			}
 
 			if (p_mixture) {
@@ -30,6 +30,7 @@
 
 #include <IO/IO.h>
 #include <IO/MisValParser.h>
+#include <IO/MixedColumn.h>
 #include <LinAlg/Maths.h>
 #include <LinAlg/names.h>
 #include <LinAlg/Typedef.h>
@@ -44,6 +45,7 @@
 #include <Mixture/Functional/FuncCSProblem.h>
 #include <Mixture/Rank/RankISRParser.h>
 #include <Run/Learn.h>
+#include <Run/LearnSweep.h>
 #include <Run/Predict.h>
 #include <Statistic/Statistic.h>
 #include <Strategy/SEMStrategy.h>
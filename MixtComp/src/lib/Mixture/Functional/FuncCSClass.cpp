@@ -25,8 +25,8 @@
 
 namespace mixt {
 
-FuncCSClass::FuncCSClass(Vector<FunctionCS>& data, Real confidenceLevel) :
-		nSub_(0), nCoeff_(0), data_(data), alphaParamStat_(alpha_, confidenceLevel), betaParamStat_(beta_, confidenceLevel), sdParamStat_(sd_, confidenceLevel) {
+FuncCSClass::FuncCSClass(Vector<FunctionCS>& data, Real confidenceLevel, ParamStatMode paramStatMode) :
+		nSub_(0), nCoeff_(0), data_(data), alphaParamStat_(alpha_, confidenceLevel, paramStatMode), betaParamStat_(beta_, confidenceLevel, paramStatMode), sdParamStat_(sd_, confidenceLevel, paramStatMode) {
 }
 
 void FuncCSClass::setSize(Index nSub, Index nCoeff) {
@@ -42,7 +42,7 @@ void FuncCSClass::setSize(Index nSub, Index nCoeff) {
 	sd_ = 0.;
 }
 
-std::string FuncCSClass::mStep(const std::set<Index>& setInd) {
+std::string FuncCSClass::mStep(const std::vector<Index>& setInd) {
 	std::string warnLog;
 
 	mStepAlpha(setInd);
@@ -51,7 +51,7 @@ std::string FuncCSClass::mStep(const std::set<Index>& setInd) {
 	return warnLog;
 }
 
-void FuncCSClass::mStepAlpha(const std::set<Index>& setInd) {
+void FuncCSClass::mStepAlpha(const std::vector<Index>& setInd) {
 	Index nSub = alpha_.rows();
 	Index nParam = 2 * nSub;
 	Index nFreeParam = 2 * (nSub - 1);
@@ -77,11 +77,11 @@ void FuncCSClass::mStepAlpha(const std::set<Index>& setInd) {
 	}
 }
 
-std::string FuncCSClass::mStepBetaSd(const std::set<Index>& setInd) {
+std::string FuncCSClass::mStepBetaSd(const std::vector<Index>& setInd) {
 	std::string warnLog;
 	Vector<Index> nTTotal(nSub_, 0);
 
-	for (std::set<Index>::const_iterator itData = setInd.begin(), itDataE = setInd.end(); itData != itDataE; ++itData) { // to create the complete design matrix and y for the class, the total number of timesteps over the class must be determined
+	for (std::vector<Index>::const_iterator itData = setInd.begin(), itDataE = setInd.end(); itData != itDataE; ++itData) { // to create the complete design matrix and y for the class, the total number of timesteps over the class must be determined
 		for (Index s = 0; s < nSub_; ++s) {
 			nTTotal(s) += data_(*itData).w()(s).size();
 		}
@@ -94,7 +94,7 @@ std::string FuncCSClass::mStepBetaSd(const std::set<Index>& setInd) {
 		y(s).resize(nTTotal(s));
 
 		Index i = 0; // current row in the global design matrix
-		for (std::set<Index>::const_iterator itData = setInd.begin(), itDataE = setInd.end(); itData != itDataE; ++itData) {
+		for (std::vector<Index>::const_iterator itData = setInd.begin(), itDataE = setInd.end(); itData != itDataE; ++itData) {
 			for (std::set<Index>::const_iterator itTime = data_(*itData).w()(s).begin(), itTimeE = data_(*itData).w()(s).end(); itTime != itTimeE; ++itTime) {
 				design(s).row(i) = data_(*itData).vandermonde().row(*itTime);
 				y(s)(i) = data_(*itData).x()(*itTime);
@@ -134,7 +134,7 @@ void FuncCSClass::sampleParam(Index iteration, Index iterationMax) {
 	sdParamStat_.sampleParam(iteration, iterationMax);
 }
 
-std::string FuncCSClass::checkSampleCondition(const std::set<Index>& setInd) const {
+std::string FuncCSClass::checkSampleCondition(const std::vector<Index>& setInd) const {
 	std::string warnLog;
 	bool value = checkNbDifferentValue(setInd);
 
@@ -145,11 +145,11 @@ std::string FuncCSClass::checkSampleCondition(const std::set<Index>& setInd) con
 	return warnLog;
 }
 
-bool FuncCSClass::checkNbDifferentValue(const std::set<Index>& setInd) const {
+bool FuncCSClass::checkNbDifferentValue(const std::vector<Index>& setInd) const {
 	for (Index s = 0; s < nSub_; ++s) {
 		std::list<Real> listT;
 
-		for (std::set<Index>::const_iterator it = setInd.begin(), itE = setInd.end(); it != itE; ++it) { // only loop on individuals in the current class
+		for (std::vector<Index>::const_iterator it = setInd.begin(), itE = setInd.end(); it != itE; ++it) { // only loop on individuals in the current class
 			for (std::set<Index>::const_iterator itW = data_(*it).w()(s).begin(), itWE = data_(*it).w()(s).end(); itW != itWE; ++itW) { // only loop on timesteps in the current subregression
 				listT.push_back(data_(*it).t()(*itW));
 			}
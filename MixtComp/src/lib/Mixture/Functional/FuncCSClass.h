@@ -32,7 +32,7 @@ namespace mixt {
 
 class FuncCSClass {
 public:
-	FuncCSClass(Vector<FunctionCS>& data, Real confidenceLevel);
+	FuncCSClass(Vector<FunctionCS>& data, Real confidenceLevel, ParamStatMode paramStatMode = exactParamStat_);
 
 	void setSize(Index nSub, Index nCoeff);
 
@@ -43,11 +43,11 @@ public:
 		sd_ = sd;
 	}
 
-	std::string mStep(const std::set<Index>& setInd);
+	std::string mStep(const std::vector<Index>& setInd);
 
-	void mStepAlpha(const std::set<Index>& setInd);
+	void mStepAlpha(const std::vector<Index>& setInd);
 
-	std::string mStepBetaSd(const std::set<Index>& setInd);
+	std::string mStepBetaSd(const std::vector<Index>& setInd);
 
 	void initParam();
 
@@ -85,8 +85,8 @@ public:
 	 * The setInd argument allows to pass either the real partition, or a temporary partition with a subset of observations.
 	 * This second case mainly occurs during initParam.
 	 */
-	std::string checkSampleCondition(const std::set<Index>& setInd) const;
-	bool checkNbDifferentValue(const std::set<Index>& setInd) const;
+	std::string checkSampleCondition(const std::vector<Index>& setInd) const;
+	bool checkNbDifferentValue(const std::vector<Index>& setInd) const;
 
 	const Matrix<Real>& getAlpha() const {
 		return alpha_;
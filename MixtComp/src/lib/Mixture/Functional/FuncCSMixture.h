@@ -36,11 +36,11 @@ namespace mixt {
 template<typename Graph>
 class FuncCSMixture: public IMixture {
 public:
-	FuncCSMixture(const Graph& data, const Graph& param, Graph& out, std::string const& idName, Index nClass, Index nObs, Real confidenceLevel, const std::string& paramStr) :
+	FuncCSMixture(const Graph& data, const Graph& param, Graph& out, std::string const& idName, Index nClass, Index nObs, Real confidenceLevel, ParamStatMode paramStatMode, const std::string& paramStr) :
 			IMixture(idName, "Func_CS", nClass, nObs), nSub_(0), nCoeff_(0), confidenceLevel_(confidenceLevel), dataG_(data), paramG_(param), outG_(out), paramStr_(paramStr) {
 		class_.reserve(nClass_);
 		for (Index k = 0; k < nClass_; ++k) {
-			class_.emplace_back(vecInd_, confidenceLevel_);
+			class_.emplace_back(vecInd_, confidenceLevel_, paramStatMode);
 		}
 
 		acceptedType_.resize(nb_enum_MisType_);
@@ -57,7 +57,7 @@ public:
 	}
 	;
 
-	std::string checkSampleCondition(const Vector<std::set<Index> >& classInd) const {
+	std::string checkSampleCondition(const Vector<std::vector<Index>>& classInd) const {
 		std::string classLog;
 		for (Index k = 0; k < nClass_; ++k) {
 			std::string currClassLog = class_[k].checkSampleCondition(classInd(k));
@@ -73,21 +73,28 @@ public:
 		return "";
 	}
 
-	std::string mStep(const Vector<std::set<Index> >& classInd) {
-		std::string warnLog;
-
-		for (Index k = 0; k < nClass_; ++k) {
-			std::string currLog;
-			currLog = class_[k].mStep(classInd(k));
-			if (0 < currLog.size()) {
-				warnLog += "Error in class " + std::to_string(k) + "." + eol + currLog;
-			}
+	std::string mStep(const Vector<std::vector<Index>>& classInd, Index k) {
+		std::string currLog = class_[k].mStep(classInd(k));
+		if (0 < currLog.size()) {
+			return "Error in class " + std::to_string(k) + "." + eol + currLog;
 		}
 
-		return warnLog;
+		return "";
 	}
 	;
 
+	/**
+	 * The alpha optimization dominates, each of its iterations evaluates the cost function on every time step of the class.
+	 */
+	Real mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const {
+		Real nTime = 0.;
+		for (std::vector<Index>::const_iterator it = classInd(k).begin(), itE = classInd(k).end(); it != itE; ++it) {
+			nTime += vecInd_(*it).t().size();
+		}
+
+		return nTime * nSub_ * maxIterationOptim;
+	}
+
 	void storeSEMRun(Index iteration, Index iterationMax) {
 		for (Index k = 0; k < nClass_; ++k) {
 			class_[k].sampleParam(iteration, iterationMax);
@@ -114,6 +121,18 @@ public:
 		return vecInd_(i).lnObservedProbability(class_[k].alpha(), class_[k].beta(), class_[k].sd());
 	}
 
+	void lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+		for (Index k = 0; k < nClass_; ++k) {
+			const Matrix<Real>& alpha = class_[k].alpha();
+			const Matrix<Real>& beta = class_[k].beta();
+			const Vector<Real>& sd = class_[k].sd();
+
+			for (Index i = iBegin; i < iEnd; ++i) {
+				lnProba(i - iBegin, k) += vecInd_(i).lnCompletedProbability(alpha, beta, sd);
+			}
+		}
+	}
+
 	Index nbFreeParameter() const {
 		return nClass_ * ((nSub_ - 1) * 2 // alpha (nSub_ -1 since alpha's are the parameters of a multivariate logistic regeression)
 		+ nSub_ * nCoeff_ // beta
@@ -140,62 +159,10 @@ public:
 	 * Note that two paramStr are considered. One is provided at creation, by the createMixture function, and the other is read at prediction.
 	 */
 	std::string setDataParam(RunMode mode) {
-		std::string warnLog;
-		NamedMatrix<Real> alpha, beta, sd;
-
 		std::vector<std::string> dataVecStr;
 		dataG_.get_payload( { }, idName_, dataVecStr); // get the raw vector of strings
 
-		if (mode == prediction_) { // prediction mode, linearized versions of the parameters are fetched, and then distributed to the classes
-			paramG_.get_payload( { idName_ }, "paramStr", paramStr_);
-
-			paramG_.get_payload( { idName_, "alpha" }, "stat", alpha);
-			paramG_.get_payload( { idName_, "beta" }, "stat", beta);
-			paramG_.get_payload( { idName_, "sd" }, "stat", sd);
-		}
-
-		// get the value of nSub_ and nCoeff_ by parsing paramStr_
-		std::string paramReStr = std::string("nSub: *") + strPositiveInteger + std::string(", nCoeff: *") + strPositiveInteger;
-		std::regex paramRe(paramReStr);
-		std::smatch matches;
-		if (std::regex_match(paramStr_, matches, paramRe)) { // value is present
-			nSub_ = str2type<Index>(matches[1].str());
-			nCoeff_ = str2type<Index>(matches[2].str());
-
-			for (Index k = 0; k < nClass_; ++k) { // call setSize on each class
-				class_[k].setSize(nSub_, nCoeff_);
-			}
-		} else {
-			std::stringstream sstm;
-			sstm << "Variable: " << idName_ << " has no parameter description. This description is required, and must take the form " << "\"nSub: x, nCoeff: y\"" << std::endl;
-			warnLog += sstm.str();
-		}
-
-		if (mode == prediction_ && warnLog.size() == 0) { // prediction mode, linearized versions of the parameters are fetched, and then distributed to the classes
-			Matrix<Real> alphaCurr(nSub_, 2);
-			Matrix<Real> betaCurr(nSub_, nCoeff_);
-			Vector<Real> sdCurr(nSub_);
-			for (Index k = 0; k < nClass_; ++k) {
-				for (Index s = 0; s < nSub_; ++s) {
-					for (Index c = 0; c < 2; ++c) {
-						alphaCurr(s, c) = alpha.mat_(k * nSub_ * 2 + s * 2 + c, 0);
-					}
-				}
-
-				for (Index s = 0; s < nSub_; ++s) {
-					for (Index c = 0; c < nCoeff_; ++c) {
-						betaCurr(s, c) = beta.mat_(k * nSub_ * nCoeff_ + s * nCoeff_ + c, 0);
-					}
-				}
-
-				for (Index s = 0; s < nSub_; ++s) {
-					sdCurr(s) = sd.mat_(k * nSub_ + s, 0);
-				}
-
-				class_[k].setParam(alphaCurr, betaCurr, sdCurr);
-				class_[k].setParamStorage();
-			}
-		}
+		std::string warnLog = setSizeParam(mode);
 
 		warnLog += parseFunctionalStr(nSub_, nCoeff_, dataVecStr, vecInd_); // convert the vector of strings to ranks
 		warnLog += checkMissingType();
@@ -211,6 +178,19 @@ public:
 		return warnLog;
 	}
 
+	std::string setDataParam(RunMode mode, const IMixture& source) {
+		std::string warnLog = setSizeParam(mode);
+		if (warnLog.size() > 0) {
+			return warnLog;
+		}
+
+		const FuncCSMixture<Graph>& sourceFunc = static_cast<const FuncCSMixture<Graph>&>(source);
+		vecInd_ = sourceFunc.vecInd_;
+		quantile_ = sourceFunc.quantile_;
+
+		return warnLog;
+	}
+
 	/**
 	 * Linearize and format the information provided by each class, and send it to the usual extractors, nothing fancy here.
 	 */
@@ -320,6 +300,65 @@ public:
 		return false;
 	}
 private:
+	/** First part of setDataParam, parse paramStr_ to set nSub_ and nCoeff_, and in prediction read the parameters. */
+	std::string setSizeParam(RunMode mode) {
+		std::string warnLog;
+		NamedMatrix<Real> alpha, beta, sd;
+
+		if (mode == prediction_) { // prediction mode, linearized versions of the parameters are fetched, and then distributed to the classes
+			paramG_.get_payload( { idName_ }, "paramStr", paramStr_);
+
+			paramG_.get_payload( { idName_, "alpha" }, "stat", alpha);
+			paramG_.get_payload( { idName_, "beta" }, "stat", beta);
+			paramG_.get_payload( { idName_, "sd" }, "stat", sd);
+		}
+
+		// get the value of nSub_ and nCoeff_ by parsing paramStr_
+		std::string paramReStr = std::string("nSub: *") + strPositiveInteger + std::string(", nCoeff: *") + strPositiveInteger;
+		std::regex paramRe(paramReStr);
+		std::smatch matches;
+		if (std::regex_match(paramStr_, matches, paramRe)) { // value is present
+			nSub_ = str2type<Index>(matches[1].str());
+			nCoeff_ = str2type<Index>(matches[2].str());
+
+			for (Index k = 0; k < nClass_; ++k) { // call setSize on each class
+				class_[k].setSize(nSub_, nCoeff_);
+			}
+		} else {
+			std::stringstream sstm;
+			sstm << "Variable: " << idName_ << " has no parameter description. This description is required, and must take the form " << "\"nSub: x, nCoeff: y\"" << std::endl;
+			warnLog += sstm.str();
+		}
+
+		if (mode == prediction_ && warnLog.size() == 0) { // prediction mode, linearized versions of the parameters are fetched, and then distributed to the classes
+			Matrix<Real> alphaCurr(nSub_, 2);
+			Matrix<Real> betaCurr(nSub_, nCoeff_);
+			Vector<Real> sdCurr(nSub_);
+			for (Index k = 0; k < nClass_; ++k) {
+				for (Index s = 0; s < nSub_; ++s) {
+					for (Index c = 0; c < 2; ++c) {
+						alphaCurr(s, c) = alpha.mat_(k * nSub_ * 2 + s * 2 + c, 0);
+					}
+				}
+
+				for (Index s = 0; s < nSub_; ++s) {
+					for (Index c = 0; c < nCoeff_; ++c) {
+						betaCurr(s, c) = beta.mat_(k * nSub_ * nCoeff_ + s * nCoeff_ + c, 0);
+					}
+				}
+
+				for (Index s = 0; s < nSub_; ++s) {
+					sdCurr(s) = sd.mat_(k * nSub_ + s, 0);
+				}
+
+				class_[k].setParam(alphaCurr, betaCurr, sdCurr);
+				class_[k].setParamStorage();
+			}
+		}
+
+		return warnLog;
+	}
+
 	std::string checkMissingType() {
 		std::string warnLog;
 		// to be populated with checks. Each Function object must have a checkMissingType
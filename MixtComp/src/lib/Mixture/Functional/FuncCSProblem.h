@@ -24,7 +24,7 @@
 #define LIB_MIXTURE_FUNCTIONAL_FUNCPROBLEM
 
 #include <LinAlg/LinAlg.h>
-#include <set>
+#include <vector>
 
 #include "cppoptlib/meta.h"
 #include "cppoptlib/problem.h"
@@ -43,7 +43,7 @@ public:
 	using typename cppoptlib::Problem<Real>::Scalar;
 	using typename cppoptlib::Problem<Real>::TVector;
 
-	FuncCSProblem(Index nParam, const Vector<FunctionCS>& data, const std::set<Index>& setInd) :
+	FuncCSProblem(Index nParam, const Vector<FunctionCS>& data, const std::vector<Index>& setInd) :
 			nParam_(nParam), alphaComplete_(nParam), gradInd_(nParam), data_(data), setInd_(setInd) {
 		alphaComplete_ = 0;
 	}
@@ -55,7 +55,7 @@ public:
 			alphaComplete_[p] = x[p - 2];
 		}
 
-		for (std::set<Index>::const_iterator it = setInd_.begin(), itE = setInd_.end(); it != itE; ++it) { // each individual in current class adds a contribution to both the cost and the gradient of alpha
+		for (std::vector<Index>::const_iterator it = setInd_.begin(), itE = setInd_.end(); it != itE; ++it) { // each individual in current class adds a contribution to both the cost and the gradient of alpha
 			cost += data_(*it).cost(alphaComplete_);
 		}
 
@@ -71,7 +71,7 @@ public:
 			alphaComplete_[p] = x[p - 2];
 		}
 
-		for (std::set<Index>::const_iterator it = setInd_.begin(), itE = setInd_.end(); it != itE; ++it) { // each individual in current class adds a contribution to both the cost and the gradient of alpha
+		for (std::vector<Index>::const_iterator it = setInd_.begin(), itE = setInd_.end(); it != itE; ++it) { // each individual in current class adds a contribution to both the cost and the gradient of alpha
 			data_(*it).grad(alphaComplete_, gradInd_);
 			for (Index p = 0; p < nParam_ - 2; ++p) {
 				grad[p] += gradInd_[p + 2];
@@ -86,7 +86,7 @@ private:
 	Vector<Real> alphaComplete_;
 	Vector<Real> gradInd_;
 	const Vector<FunctionCS>& data_;
-	const std::set<Index>& setInd_;
+	const std::vector<Index>& setInd_;
 };
 
 }
@@ -23,8 +23,8 @@
 #ifndef FUNCTIONALSHAREDALPHAMIXTURE
 #define FUNCTIONALSHAREDALPHAMIXTURE
 
+#include <algorithm>
 #include <vector>
-#include <set>
 #include <IO/IOFunctions.h>
 #include <IO/NamedAlgebra.h>
 #include <Mixture/Functional/FuncCSClass.h>
@@ -37,11 +37,11 @@ namespace mixt {
 template<typename Graph>
 class FuncSharedAlphaCSMixture: public IMixture {
 public:
-	FuncSharedAlphaCSMixture(const Graph& data, const Graph& param, Graph& out, std::string const& idName, Index nClass, Index nObs, Real confidenceLevel, const std::string& paramStr) :
+	FuncSharedAlphaCSMixture(const Graph& data, const Graph& param, Graph& out, std::string const& idName, Index nClass, Index nObs, Real confidenceLevel, ParamStatMode paramStatMode, const std::string& paramStr) :
 			IMixture(idName, "Func_SharedAlpha_CS", nClass, nObs), nSub_(0), nCoeff_(0), confidenceLevel_(confidenceLevel), dataG_(data), paramG_(param), outG_(out), paramStr_(paramStr) {
 		class_.reserve(nClass_);
 		for (Index k = 0; k < nClass_; ++k) {
-			class_.emplace_back(vecInd_, confidenceLevel_);
+			class_.emplace_back(vecInd_, confidenceLevel_, paramStatMode);
 		}
 
 		acceptedType_.resize(nb_enum_MisType_);
@@ -59,7 +59,7 @@ public:
 	;
 
 
-	std::string checkSampleCondition(const Vector<std::set<Index> >& classInd) const {
+	std::string checkSampleCondition(const Vector<std::vector<Index>>& classInd) const {
 		std::string classLog;
 		for (Index k = 0; k < nClass_; ++k) {
 			std::string currClassLog = class_[k].checkSampleCondition(classInd(k));
@@ -77,33 +77,43 @@ public:
 
 	/**
 	 * This is the main implementation difference between Functional and FunctionalSharedAlpha. Note that
-	 * FunctionalClass::mStep is never called.
+	 * FunctionalClass::mStep is never called. Alpha is estimated on all the individuals in mStepShared, then beta and sd
+	 * are estimated independently in each class.
 	 */
-	std::string mStep(const Vector<std::set<Index> >& classInd) {
-		std::string warnLog;
-
-		std::set<Index> setAllObs;
+	std::string mStepShared(const Vector<std::vector<Index>>& classInd, const std::vector<Index>*) {
+		std::vector<Index> setAllObs;
 
 		for (Index k = 0; k < nClass_; ++k) { // build the set of all observations
-			for (std::set<Index>::const_iterator it = classInd(k).begin(), itEnd = classInd(k).end(); it != itEnd; ++it) {
-				setAllObs.insert(*it);
-			}
+			setAllObs.insert(setAllObs.end(), classInd(k).begin(), classInd(k).end());
 		}
+		std::sort(setAllObs.begin(), setAllObs.end()); // same order of summation as the full partition
 
 		class_[0].mStepAlpha(setAllObs); // perform the mStep in the first class using all the individuals
 		broadcastAlpha(); // broadcast the results to all classes
 
-		for (Index k = 0; k < nClass_; ++k) { // build the set of all observations
-			std::string currLog;
-			currLog = class_[k].mStepBetaSd(classInd(k));
-			if (0 < currLog.size()) {
-				warnLog += "Error in class " + std::to_string(k) + "." + eol + currLog;
-			}
+		return "";
+	}
+
+	std::string mStep(const Vector<std::vector<Index>>& classInd, Index k) {
+		std::string currLog = class_[k].mStepBetaSd(classInd(k));
+		if (0 < currLog.size()) {
+			return "Error in class " + std::to_string(k) + "." + eol + currLog;
 		}
 
-		return warnLog;
+		return "";
+	}
+
+	/**
+	 * Only the regression on the time steps of the class, since alpha is estimated in mStepShared.
+	 */
+	Real mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const {
+		Real nTime = 0.;
+		for (std::vector<Index>::const_iterator it = classInd(k).begin(), itE = classInd(k).end(); it != itE; ++it) {
+			nTime += vecInd_(*it).t().size();
+		}
+
+		return nTime * nCoeff_;
 	}
-	;
 
 	/**
 	 * Broadcast the alpha parameters from the first class to all classes.
@@ -141,6 +151,18 @@ public:
 		return vecInd_(i).lnObservedProbability(class_[k].alpha(), class_[k].beta(), class_[k].sd());
 	}
 
+	void lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+		for (Index k = 0; k < nClass_; ++k) {
+			const Matrix<Real>& alpha = class_[k].alpha();
+			const Matrix<Real>& beta = class_[k].beta();
+			const Vector<Real>& sd = class_[k].sd();
+
+			for (Index i = iBegin; i < iEnd; ++i) {
+				lnProba(i - iBegin, k) += vecInd_(i).lnCompletedProbability(alpha, beta, sd);
+			}
+		}
+	}
+
 	Index nbFreeParameter() const {
 		return nClass_ * ((nSub_ - 1) * 2 // alpha (nSub_ -1 since alpha's are the parameters of a multivariate logistic regeression)
 		+ nSub_ * nCoeff_ // beta
@@ -163,62 +185,10 @@ public:
 	;
 
 	std::string setDataParam(RunMode mode) {
-		std::string warnLog;
-		NamedVector<Real> alpha, beta, sd;
-
 		std::vector<std::string> dataVecStr;
 		dataG_.get_payload( { }, idName_, dataVecStr); // get the raw vector of strings
 
-		if (mode == prediction_) { // prediction mode, linearized versions of the parameters are fetched, and then distributed to the classes
-			paramG_.get_payload( { idName_ }, "paramStr", paramStr_);
-
-			paramG_.get_payload( { idName_, "alpha" }, "stat", alpha);
-			paramG_.get_payload( { idName_, "beta" }, "stat", beta);
-			paramG_.get_payload( { idName_, "sd" }, "stat", sd);
-		}
-
-		// get the value of nSub_ and nCoeff_ by parsing paramStr_
-		std::string paramReStr = std::string("nSub: *") + strPositiveInteger + std::string(", nCoeff: *") + strPositiveInteger;
-		std::regex paramRe(paramReStr);
-		std::smatch matches;
-		if (std::regex_match(paramStr_, matches, paramRe)) { // value is present
-			nSub_ = str2type<Index>(matches[1].str());
-			nCoeff_ = str2type<Index>(matches[2].str());
-
-			for (Index k = 0; k < nClass_; ++k) { // call setSize on each class
-				class_[k].setSize(nSub_, nCoeff_);
-			}
-		} else {
-			std::stringstream sstm;
-			sstm << "Variable: " << idName_ << " has no parameter description. This description is required, and must take the form " << "\"nSub: x, nCoeff: y\"" << std::endl;
-			warnLog += sstm.str();
-		}
-
-		if (mode == prediction_ && warnLog.size() == 0) { // prediction mode, linearized versions of the parameters are fetched, and then distributed to the classes
-			Matrix<Real> alphaCurr(nSub_, 2);
-			Matrix<Real> betaCurr(nSub_, nCoeff_);
-			Vector<Real> sdCurr(nSub_);
-			for (Index k = 0; k < nClass_; ++k) {
-				for (Index s = 0; s < nSub_; ++s) {
-					for (Index c = 0; c < 2; ++c) {
-						alphaCurr(s, c) = alpha.vec_(k * nSub_ * 2 + s * 2 + c);
-					}
-				}
-
-				for (Index s = 0; s < nSub_; ++s) {
-					for (Index c = 0; c < nCoeff_; ++c) {
-						betaCurr(s, c) = beta.vec_(k * nSub_ * nCoeff_ + s * nCoeff_ + c);
-					}
-				}
-
-				for (Index s = 0; s < nSub_; ++s) {
-					sdCurr(s) = sd.vec_(k * nSub_ + s);
-				}
-
-				class_[k].setParam(alphaCurr, betaCurr, sdCurr);
-				class_[k].setParamStorage();
-			}
-		}
+		std::string warnLog = setSizeParam(mode);
 
 		warnLog += parseFunctionalStr(nSub_, nCoeff_, dataVecStr, vecInd_); // convert the vector of strings to ranks
 		warnLog += checkMissingType();
@@ -234,6 +204,19 @@ public:
 		return warnLog;
 	}
 
+	std::string setDataParam(RunMode mode, const IMixture& source) {
+		std::string warnLog = setSizeParam(mode);
+		if (warnLog.size() > 0) {
+			return warnLog;
+		}
+
+		const FuncSharedAlphaCSMixture<Graph>& sourceFunc = static_cast<const FuncSharedAlphaCSMixture<Graph>&>(source);
+		vecInd_ = sourceFunc.vecInd_;
+		quantile_ = sourceFunc.quantile_;
+
+		return warnLog;
+	}
+
 	void exportDataParam() const {
 		std::vector<std::vector<Real>> data(nInd_);
 		std::vector<std::vector<Real>> time(nInd_);
@@ -338,6 +321,65 @@ public:
 		return false;
 	}
 private:
+	/** First part of setDataParam, parse paramStr_ to set nSub_ and nCoeff_, and in prediction read the parameters. */
+	std::string setSizeParam(RunMode mode) {
+		std::string warnLog;
+		NamedVector<Real> alpha, beta, sd;
+
+		if (mode == prediction_) { // prediction mode, linearized versions of the parameters are fetched, and then distributed to the classes
+			paramG_.get_payload( { idName_ }, "paramStr", paramStr_);
+
+			paramG_.get_payload( { idName_, "alpha" }, "stat", alpha);
+			paramG_.get_payload( { idName_, "beta" }, "stat", beta);
+			paramG_.get_payload( { idName_, "sd" }, "stat", sd);
+		}
+
+		// get the value of nSub_ and nCoeff_ by parsing paramStr_
+		std::string paramReStr = std::string("nSub: *") + strPositiveInteger + std::string(", nCoeff: *") + strPositiveInteger;
+		std::regex paramRe(paramReStr);
+		std::smatch matches;
+		if (std::regex_match(paramStr_, matches, paramRe)) { // value is present
+			nSub_ = str2type<Index>(matches[1].str());
+			nCoeff_ = str2type<Index>(matches[2].str());
+
+			for (Index k = 0; k < nClass_; ++k) { // call setSize on each class
+				class_[k].setSize(nSub_, nCoeff_);
+			}
+		} else {
+			std::stringstream sstm;
+			sstm << "Variable: " << idName_ << " has no parameter description. This description is required, and must take the form " << "\"nSub: x, nCoeff: y\"" << std::endl;
+			warnLog += sstm.str();
+		}
+
+		if (mode == prediction_ && warnLog.size() == 0) { // prediction mode, linearized versions of the parameters are fetched, and then distributed to the classes
+			Matrix<Real> alphaCurr(nSub_, 2);
+			Matrix<Real> betaCurr(nSub_, nCoeff_);
+			Vector<Real> sdCurr(nSub_);
+			for (Index k = 0; k < nClass_; ++k) {
+				for (Index s = 0; s < nSub_; ++s) {
+					for (Index c = 0; c < 2; ++c) {
+						alphaCurr(s, c) = alpha.vec_(k * nSub_ * 2 + s * 2 + c);
+					}
+				}
+
+				for (Index s = 0; s < nSub_; ++s) {
+					for (Index c = 0; c < nCoeff_; ++c) {
+						betaCurr(s, c) = beta.vec_(k * nSub_ * nCoeff_ + s * nCoeff_ + c);
+					}
+				}
+
+				for (Index s = 0; s < nSub_; ++s) {
+					sdCurr(s) = sd.vec_(k * nSub_ + s);
+				}
+
+				class_[k].setParam(alphaCurr, betaCurr, sdCurr);
+				class_[k].setParamStorage();
+			}
+		}
+
+		return warnLog;
+	}
+
 	std::string checkMissingType() {
 		std::string warnLog;
 		// to be populated with checks. Each Function object must have a checkMissingType
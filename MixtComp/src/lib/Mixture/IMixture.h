@@ -26,7 +26,7 @@
 
 #include <LinAlg/LinAlg.h>
 #include <iostream>
-#include <set>
+#include <vector>
 #include <Various/Enum.h>
 
 namespace mixt {
@@ -86,17 +86,45 @@ public:
 	 *
 	 * @return 0 if condition not verified and 1 if condition verified
 	 * */
-	virtual std::string checkSampleCondition(const Vector<std::set<Index>>& classInd) const = 0;
+	virtual std::string checkSampleCondition(const Vector<std::vector<Index>>& classInd) const = 0;
 
 	/**
-	 * Maximum-Likelihood estimation of the mixture parameters
+	 * Part of the Maximum-Likelihood estimation shared by all classes, for example a parameter common to all classes. It
+	 * is called before the mStep of the individual classes. Most models have nothing to do here.
 	 *
 	 * @param classInd A vector containing in each element a vector of the indices of individuals
-	 * that belong to this class (see ZClassInd class.
+	 * that belong to this class (see ZClassInd class).
+	 * @param movedInd if classInd is the partition of z, individuals whose class may have changed since the previous
+	 * call on the partition of z, so that statistics kept between calls can be updated on these individuals only.
+	 * nullptr if classInd is another partition, for example the sub partition of MixtureComposer::initParamSubPartition.
+	 *
+	 * @return empty string if mStep successful, or a detailed description of the eventual error
+	 * */
+	virtual std::string mStepShared(const Vector<std::vector<Index>>&, const std::vector<Index>*) {
+		return "";
+	}
+
+	/**
+	 * Maximum-Likelihood estimation of the parameters of class k. The estimations of the different classes are
+	 * independent, and MixtureComposer may run them concurrently, hence this method must only modify the parameters of
+	 * class k.
+	 *
+	 * @param classInd A vector containing in each element a vector of the indices of individuals
+	 * that belong to this class (see ZClassInd class).
+	 * @param k class whose parameters are estimated
 	 *
 	 * @return empty string if mStep successful, or a detailed description of the eventual error
 	 * */
-	virtual std::string mStep(const Vector<std::set<Index>>& classInd) = 0;
+	virtual std::string mStep(const Vector<std::vector<Index>>& classInd, Index k) = 0;
+
+	/**
+	 * Estimation of the relative cost of mStep(classInd, k), used by MixtureComposer to start the most expensive
+	 * (variable, class) units first. Only the order of magnitude between models matters. The default is the number of
+	 * individuals in the class.
+	 * */
+	virtual Real mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const {
+		return classInd(k).size();
+	}
 
 	/**
 	 * Storage of mixture parameters during SEM run phase
@@ -116,6 +144,17 @@ public:
 	 * */
 	virtual void storeGibbsRun(Index i, Index iteration, Index iterationMax) = 0;
 
+	/**
+	 * Called once before the first storeGibbsRun of the Gibbs run phase, so that the storage shared by all the
+	 * individuals can be allocated independently of the order in which they are visited.
+	 *
+	 * @param iterationMax maximum number of iterations
+	 * */
+	virtual void beginGibbsRun(Index) {}
+
+	/** Called once after the last storeGibbsRun of the Gibbs run phase, to free the shared storage */
+	virtual void endGibbsRun() {}
+
 	/**
 	 * Computation of completed likelihood
 	 *
@@ -134,6 +173,50 @@ public:
 	 * */
 	virtual Real lnObservedProbability(Index ind, Index k) const = 0;
 
+	/**
+	 * Contribution of the variable to the completed likelihood of a block of individuals in every class, in a single
+	 * call. This is what the E step of MixtureComposer uses, so that there is one virtual call per variable and per
+	 * block instead of one per cell. It is called concurrently on disjoint blocks.
+	 *
+	 * @param iBegin first individual of the block
+	 * @param iEnd individual after the last individual of the block
+	 * @param[in,out] lnProba (iEnd - iBegin) x nClass matrix, row c corresponds to individual iBegin + c. The log
+	 * probabilities are added to its content.
+	 * */
+	virtual void lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const = 0;
+
+	/**
+	 * Dirty tracking for the cache of completed probabilities of MixtureComposer. It is called once per E step, just
+	 * before the completed probabilities of the variable are computed, and tells which of them may differ from the ones
+	 * computed at the previous call.
+	 *
+	 * @param[out] staleInd if the function returns false, sorted indices of the individuals whose completed data may have
+	 * been modified since the previous call, for example by the sampling of missing or latent values
+	 * @return true if every completed probability must be recomputed, for example because the parameters have changed.
+	 * The default always returns true, hence the variable is not cached.
+	 * */
+	virtual bool staleCompletedProbability(std::vector<Index>&) {
+		return true;
+	}
+
+	/**
+	 * Computation of observed likelihood for a block of individuals in every class, in a single call. This is used to
+	 * fill the observed probability cache of MixtureComposer, and is called concurrently on disjoint blocks. The default
+	 * implementation calls lnObservedProbability(i, k) for each cell, models can override it to avoid one virtual call
+	 * per cell.
+	 *
+	 * @param iBegin first individual of the block
+	 * @param iEnd individual after the last individual of the block
+	 * @param[out] lnProba (iEnd - iBegin) x nClass matrix, row c receives the log probabilities of individual iBegin + c
+	 * */
+	virtual void lnObservedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+		for (Index k = 0; k < nClass_; ++k) {
+			for (Index i = iBegin; i < iEnd; ++i) {
+				lnProba(i - iBegin, k) = lnObservedProbability(i, k);
+			}
+		}
+	}
+
 	/**
 	 * Computation of the number of free parameters.
 	 *
@@ -152,6 +235,17 @@ public:
 	 * */
 	virtual std::string setDataParam(RunMode mode) = 0;
 
+	/**
+	 * Initialization of the data and parameters, with the data copied from source instead of being read and parsed
+	 * from the data Graph. This is used to fit several numbers of classes on data parsed only once.
+	 *
+	 * @param mode run mode, for example learning or prediction
+	 * @param source mixture of the same type on the same variable, on which setDataParam has succeeded, and which has not
+	 * been run yet. Its number of classes can be different.
+	 * @return empty string if no errors, otherwise errors description
+	 * */
+	virtual std::string setDataParam(RunMode mode, const IMixture& source) = 0;
+
 	/**
 	 * Export of parameters and data
 	 * */
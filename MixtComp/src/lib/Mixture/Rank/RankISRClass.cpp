@@ -27,11 +27,11 @@ RankISRClass::RankISRClass(const Vector<RankISRIndividual>& data, RankVal& mu, R
 		nbInd_(data.size()), data_(data), mu_(mu), pi_(pi) {
 }
 
-Real RankISRClass::lnCompletedProbability(const std::set<Index>& setInd) const {
+Real RankISRClass::lnCompletedProbability(const std::vector<Index>& setInd) const {
 	Real logProba = 0.;
 	int a, g; // a and g are only used in the mStep, here they are dummy variables
 
-	for (std::set<Index>::const_iterator it = setInd.begin(), itEnd =
+	for (std::vector<Index>::const_iterator it = setInd.begin(), itEnd =
 			setInd.end(); it != itEnd; ++it) {
 		logProba += data_(*it).lnCompletedProbability(mu_, pi_, a, g);
 	}
@@ -39,13 +39,13 @@ Real RankISRClass::lnCompletedProbability(const std::set<Index>& setInd) const {
 	return logProba;
 }
 
-Real RankISRClass::lnCompletedProbability(const std::set<Index>& setInd, int& a,
+Real RankISRClass::lnCompletedProbability(const std::vector<Index>& setInd, int& a,
 		int& g) const {
 	Real logProba = 0.;
 	a = 0;
 	g = 0;
 
-	for (std::set<Index>::const_iterator it = setInd.begin(), itEnd =
+	for (std::vector<Index>::const_iterator it = setInd.begin(), itEnd =
 			setInd.end(); it != itEnd; ++it) {
 		int currA, currG;
 		logProba += data_(*it).lnCompletedProbability(mu_, pi_, currA, currG);
@@ -62,6 +62,14 @@ Real RankISRClass::lnCompletedProbabilityInd(int i) const {
 }
 
 Real RankISRClass::lnObservedProbability(int i) const {
+	if (sampleApproximationOfObservedProba()) {
+		return lnObservedProbabilitySampling(i);
+	}
+
+	return lnObservedProba_(i);
+}
+
+Real RankISRClass::lnObservedProbabilitySampling(int i) const {
 	Real logProba;
 
 	if (data_(i).allMissing()) {
@@ -69,26 +77,25 @@ Real RankISRClass::lnObservedProbability(int i) const {
 		std::cout << "RankISRClass::lnObservedProbability, allMissing" << std::endl;
 #endif
 
-		logProba = 0.; // using enumCompleted on a completely missing individual might by computationally intractable for a high number of positions
+		logProba = 0.; // enumerating the completions of a completely missing individual might by computationally intractable for a high number of positions
 	} else {
 #ifdef MC_DEBUG
-		std::cout << "RankISRClass::lnObservedProbability, enumCompleted" << std::endl;
+		std::cout << "RankISRClass::lnObservedProbability, forEachCompleted" << std::endl;
 #endif
 
-		std::list<RankVal> allCompleted = data_(i).enumCompleted(); // get the list of all possible completions of observation i
-		Vector<Real> allCompletedProba(allCompleted.size()); // used to "linearize" the storage of probabilities from allCompleted
+		Vector<Real> allCompletedProba(int(data_(i).nbCompleted())); // log-probabilities of all possible completions of observation i
 
 		int c = 0;
-		for (std::list<RankVal>::const_iterator it = allCompleted.begin(), itE =
-				allCompleted.end(); it != itE; ++c, ++it) {
-			std::map<RankVal, Real>::const_iterator itM =
-					observedProbaSampling_.find(*it); // has the current completion been observed in computeObservedProba ?
+		data_(i).forEachCompleted([&](const RankVal& rv) {
+			std::unordered_map<RankVal, Real, RankValHash>::const_iterator itM =
+					observedProbaSampling_.find(rv); // has the current completion been observed in computeObservedProba ?
 			if (itM == observedProbaSampling_.end()) { // the current individual has not been observed during sampling
 				allCompletedProba(c) = minInf;
 			} else {
 				allCompletedProba(c) = std::log(itM->second);
 			}
-		}
+			++c;
+		});
 
 #ifdef MC_DEBUG
 		std::cout << "RankISRMixture::lnObservedProbability, allCompletedProba.size(): " << allCompletedProba.size() << ", allCompletedProba: " << itString(allCompletedProba) << std::endl;
@@ -101,15 +108,55 @@ Real RankISRClass::lnObservedProbability(int i) const {
 	return logProba;
 }
 
-void RankISRClass::sampleMu(const std::set<Index>& setInd) {
+void RankISRClass::comparisonCount(const std::vector<Index>& setInd, Matrix<int>& comparison, int& a) const {
+	comparison.resize(mu_.nbPos(), mu_.nbPos());
+	comparison.setZero();
+
+	for (std::vector<Index>::const_iterator it = setInd.begin(), itEnd =
+			setInd.end(); it != itEnd; ++it) {
+		data_(*it).comparisonCount(comparison);
+	}
+
+	a = comparison.sum();
+}
+
+int RankISRClass::nbCorrectComparison(const Matrix<int>& comparison) const {
+	RankVal::ConstView muR = mu_.r();
+	int g = 0;
+
+	for (int e = 0; e < mu_.nbPos(); ++e) {
+		for (int f = 0; f < mu_.nbPos(); ++f) {
+			if (muR(e) < muR(f)) {
+				g += comparison(e, f);
+			}
+		}
+	}
+
+	return g;
+}
+
+void RankISRClass::sampleMu(const std::vector<Index>& setInd) {
+	Matrix<int> comparison;
+	int a;
+	comparisonCount(setInd, comparison, a);
+	int g = nbCorrectComparison(comparison);
+
+	sampleMu(comparison, a, g);
+}
+
+void RankISRClass::sampleMu(const Matrix<int>& comparison, int a, int& g) {
 	Vector<Real, 2> logProba; // first element: current log proba, second element: logProba of permuted state
 	Vector<Real, 2> proba; // multinomial distribution obtained from the logProba
+	Real logPi = std::log(pi_);
+	Real logOneMinusPi = std::log(1. - pi_);
 
-	logProba(0) = lnCompletedProbability(setInd); // proba of current mu
+	logProba(0) = g * logPi + (a - g) * logOneMinusPi; // proba of current mu, up to the normalization of the individuals which does not depend on mu
 
 	for (int p = 0; p < mu_.nbPos() - 1; ++p) {
-		mu_.permutation(p);
-		logProba(1) = lnCompletedProbability(setInd);
+		int first = mu_.o()(p);
+		int second = mu_.o()(p + 1);
+		int gPermuted = g + comparison(second, first) - comparison(first, second); // only the comparisons between first and second change their correctness
+		logProba(1) = gPermuted * logPi + (a - gPermuted) * logOneMinusPi;
 		proba.logToMulti(logProba);
 
 #ifdef MC_DEBUG
@@ -117,24 +164,28 @@ void RankISRClass::sampleMu(const std::set<Index>& setInd) {
 #endif
 
 		if (multi_.sample(proba) == 1) { // switch to permuted state ?
+			mu_.permutation(p);
+			g = gPermuted;
 			logProba(0) = logProba(1); // accept permutation
-		} else {
-			mu_.permutation(p); // revert to previous state
 		}
 	}
 }
 
-void RankISRClass::mStep(const std::set<Index>& setInd) {
+void RankISRClass::mStep(const std::vector<Index>& setInd) {
 	Vector<RankVal> mu(nbGibbsIterRankMStep);
 	Vector<Real> pi(nbGibbsIterRankMStep);
 	Vector<Real> logProba(nbGibbsIterRankMStep);
 
-	int a, g;
+	Matrix<int> comparison; // the data is not modified during the mStep
+	int a;
+	comparisonCount(setInd, comparison, a);
+	int g = nbCorrectComparison(comparison);
+
 	int i = 0;
 	while (i < nbGibbsIterRankMStep) {
-		sampleMu(setInd);
+		sampleMu(comparison, a, g);
 		mu(i) = mu_;
-		logProba(i) = lnCompletedProbability(setInd, a, g);
+		logProba(i) = g * std::log(pi_) + (a - g) * std::log(1. - pi_); // lnCompletedProbability(setInd), up to a constant
 		pi(i) = Real(g) / Real(a);
 
 		if (0 < g && g < a) {
@@ -150,6 +201,40 @@ void RankISRClass::mStep(const std::set<Index>& setInd) {
 }
 
 void RankISRClass::computeObservedProba() {
+	if (!sampleApproximationOfObservedProba()) {
+		observedProbaSampling_.clear();
+		int nbInd = data_.size(); // nbInd_ is set at construction, possibly before the data
+		lnObservedProba_.resize(nbInd);
+
+		std::unordered_map<std::uint64_t, Real> lnProbaCompleted; // exact log-probability of the completions already met, by RankVal::index, which is valid since nbPosExactRank <= RankVal::nbPosIndexMax
+		for (int i = 0; i < nbInd; ++i) {
+			if (data_(i).allMissing()) {
+				lnObservedProba_(i) = 0.;
+				continue;
+			}
+
+			Vector<Real> allCompletedProba(int(data_(i).nbCompleted()));
+
+			int c = 0;
+			data_(i).forEachCompleted([&](const RankVal& rv) {
+				std::uint64_t index = rv.index();
+				std::unordered_map<std::uint64_t, Real>::const_iterator itM = lnProbaCompleted.find(index);
+				if (itM == lnProbaCompleted.end()) {
+					itM = lnProbaCompleted.emplace(index, RankISRIndividual::lnMarginalProbability(rv, mu_, pi_)).first;
+				}
+				allCompletedProba(c) = itM->second;
+				++c;
+			});
+
+			Vector<Real> dummy;
+			lnObservedProba_(i) = dummy.logToMulti(allCompletedProba);
+		}
+
+		return;
+	}
+
+	lnObservedProba_.resize(0);
+
 	RankISRIndividual ri(mu_.nbPos()); // dummy rank individual used to compute a Vector<std::map<RankVal, Real> > for each class
 	Vector<MisVal> obsData(mu_.nbPos(), MisVal(missing_, { })); // individual is completely missing, so that remove missing will reinitialize everything upon call
 	ri.setObsData(obsData);
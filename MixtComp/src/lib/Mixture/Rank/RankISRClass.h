@@ -26,7 +26,8 @@
 #include <Mixture/IMixture.h>
 #include <Mixture/Rank/RankISRIndividual.h>
 #include <Mixture/Rank/RankVal.h>
-#include <set>
+#include <unordered_map>
+#include <vector>
 
 
 namespace mixt {
@@ -41,22 +42,58 @@ public:
 	/** Constructor with data and parameters provided. useful for unit-testing. */
 	RankISRClass(const Vector<RankISRIndividual>& data, RankVal& mu, Real& pi);
 
-	Real lnCompletedProbability(const std::set<Index>& setInd) const;
+	Real lnCompletedProbability(const std::vector<Index>& setInd) const;
 
-	Real lnCompletedProbability(const std::set<Index>& setInd, int& a, int& g) const;
+	Real lnCompletedProbability(const std::vector<Index>& setInd, int& a, int& g) const;
 
 	Real lnCompletedProbabilityInd(int i) const;
 
+	/** Observed log-probability of individual i, as computed by the last call to computeObservedProba. */
 	Real lnObservedProbability(int i) const;
 
-	/** Perform one round of Gibbs sampling for the central rank */
-	void sampleMu(const std::set<Index>& setInd);
-
-	/** */
-	void mStep(const std::set<Index>& setInd);
-
+	/**
+	 * Perform one round of Gibbs sampling for the central rank. The comparisons made by the insertion sorts of the
+	 * individuals do not depend on mu, see RankISRIndividual::comparisonCount. Hence they are counted once, and the
+	 * variation of g for the permutation of two adjacent elements of mu is obtained in O(1).
+	 */
+	void sampleMu(const std::vector<Index>& setInd);
+
+	/** The comparisons are counted once, and shared by the nbGibbsIterRankMStep calls to sampleMu */
+	void mStep(const std::vector<Index>& setInd);
+
+	/**
+	 * Computation of the observed probabilities for the current mu and pi. Up to nbPosExactRank positions, the
+	 * observed log-probability of each individual is computed exactly, by summing the exact probabilities of its
+	 * completions, which are cached since individuals often share completions. Above, the distribution of the
+	 * ranks is estimated by sampling, and the completions that have not been sampled have a probability of 0.
+	 */
 	void computeObservedProba();
+
+	/** Whether the observed probabilities are estimated by sampling, see computeObservedProba */
+	bool sampleApproximationOfObservedProba() const {
+		return nbPosExactRank < mu_.nbPos();
+	}
 private:
+	/**
+	 * Sum of the comparisons of the individuals of setInd, see RankISRIndividual::comparisonCount, and the total number
+	 * of comparisons a, which does not depend on mu.
+	 */
+	void comparisonCount(const std::vector<Index>& setInd, Matrix<int>& comparison, int& a) const;
+
+	/** Number of correct comparisons g according to mu_ */
+	int nbCorrectComparison(const Matrix<int>& comparison) const;
+
+	/**
+	 * Perform one round of Gibbs sampling for the central rank, from the comparisons made in the class
+	 * @param comparison see comparisonCount
+	 * @param a total number of comparisons
+	 * @param[in,out] g number of correct comparisons according to mu_, updated with mu_
+	 */
+	void sampleMu(const Matrix<int>& comparison, int a, int& g);
+
+	/** Observed log-probability of individual i, from the completions that have been sampled */
+	Real lnObservedProbabilitySampling(int i) const;
+
 	int nbInd_;
 
 	/** Data */
@@ -70,9 +107,11 @@ private:
 
 	MultinomialStatistic multi_;
 
-	/** Vector of map containing observed probability distribution, used in independent sampling estimation.
-	 * Each element of the vector corresponds to a class */
-	std::map<RankVal, Real> observedProbaSampling_;
+	/** Observed log-probability of each individual, when it is computed exactly */
+	Vector<Real> lnObservedProba_;
+
+	/** Observed probability distribution estimated by sampling, when it is not computed exactly */
+	std::unordered_map<RankVal, Real, RankValHash> observedProbaSampling_;
 };
 
 } // namespace mixt
@@ -22,11 +22,68 @@
 
 #include <LinAlg/Maths.h>
 #include <Mixture/Rank/RankISRIndividual.h>
-#include<set>
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <vector>
 
 
 namespace mixt {
 
+namespace {
+
+/**
+ * Set of positions 0 to n - 1 of a rank, occupied by the elements inserted, stored as a bit vector. rank and select
+ * are computed with a popcount per word of 64 positions, without data dependent branches, which for the sizes of ranks
+ * is faster than a Fenwick tree. The words are provided by the caller, so that several sets share a single allocation.
+ */
+class PositionSet {
+public:
+	PositionSet(int n, std::uint64_t* words) :
+			nWord_(nbWord(n)), words_(words) {
+		std::fill(words_, words_ + nWord_, 0);
+	}
+
+	static int nbWord(int n) {
+		return (n + 63) / 64;
+	}
+
+	void insert(int pos) {
+		words_[pos / 64] |= std::uint64_t(1) << (pos % 64);
+	}
+
+	/** Number of occupied positions strictly before pos */
+	int countBefore(int pos) const {
+		int c = 0;
+		for (int w = 0; w < pos / 64; ++w) {
+			c += popCount(words_[w]);
+		}
+		return c + popCount(words_[pos / 64] & ((std::uint64_t(1) << (pos % 64)) - 1));
+	}
+
+	/** First occupied position strictly after pos, which must exist */
+	int next(int pos) const {
+		int w = (pos + 1) / 64;
+		std::uint64_t word = words_[w] & ~((std::uint64_t(1) << ((pos + 1) % 64)) - 1);
+		while (word == 0) {
+			word = words_[++w];
+		}
+		return 64 * w + popCount((word & (~word + 1)) - 1); // index of the lowest bit set
+	}
+
+private:
+	static int popCount(std::uint64_t word) {
+		return std::bitset<64>(word).count();
+	}
+
+	int nWord_;
+
+	std::uint64_t* words_;
+};
+}
+
 RankISRIndividual::RankISRIndividual() :
 		nbPos_(0), lnFacNbPos_(0), allPresent_(true), allMissing_(true) {
 }
@@ -57,6 +114,8 @@ RankISRIndividual& RankISRIndividual::operator=(const RankISRIndividual& ri) {
 	obsData_ = ri.obsData_;
 	x_ = ri.x_;
 	y_ = ri.y_;
+	allPresent_ = ri.allPresent_;
+	allMissing_ = ri.allMissing_;
 
 	return *this;
 } // note that the state of multi_ is not copied and a new rng is created
@@ -85,14 +144,71 @@ void RankISRIndividual::removeMissing() {
 		std::iota(xVec.begin(), xVec.end(), 0);
 		x_.setO(xVec);
 	} else { // uniform sampling on all the possible completions
-		std::list<RankVal> rankList = enumCompleted();
+		sampleCompleted();
+	}
+}
+
+void RankISRIndividual::sampleCompleted() {
+	std::vector<bool> used;
+	if (!reservePresent(used)) {
+		return;
+	}
+
+	Real nbCompletion = nbCompleted(0, used);
+	if (nbCompletion == 0.) {
+		return;
+	}
 
-		int sampledIndex = multi_.sampleInt(0, rankList.size() - 1);
-		std::list<RankVal>::const_iterator it = rankList.begin();
-		std::advance(it, sampledIndex);
+	bool byIndex = nbCompletion <= std::numeric_limits<int>::max();
+	Real index = byIndex ? multi_.sampleInt(0, int(nbCompletion) - 1) : 0.;
+	Vector<int> completedVec(nbPos_);
 
-		x_ = *it;
+	for (int p = 0; p < nbPos_; ++p) {
+		if (obsData_(p).first == present_) {
+			completedVec(p) = x_.o()(p);
+			continue;
+		}
+
+		int nbCand = nbCandidate(p);
+		int sampledCand = 0;
+
+		if (byIndex) {
+			for (int c = 0; c < nbCand; ++c) {
+				int m = candidate(p, c);
+				if (used[m]) {
+					continue;
+				}
+
+				used[m] = true;
+				Real nbCompletionCand = nbCompleted(p + 1, used); // number of completions of the next positions with the candidate c
+				used[m] = false;
+
+				if (index < nbCompletionCand) {
+					sampledCand = c;
+					break;
+				}
+				index -= nbCompletionCand;
+			}
+		} else {
+			Vector<Real> proba(nbCand, 0.);
+			for (int c = 0; c < nbCand; ++c) {
+				int m = candidate(p, c);
+				if (!used[m]) {
+					used[m] = true;
+					proba(c) = nbCompleted(p + 1, used);
+					used[m] = false;
+				}
+			}
+
+			proba /= proba.sum();
+			sampledCand = multi_.sample(proba);
+		}
+
+		completedVec(p) = candidate(p, sampledCand);
+		used[completedVec(p)] = true;
 	}
+
+	x_.setO(completedVec);
 }
 
 void RankISRIndividual::yGen() {
@@ -100,19 +216,12 @@ void RankISRIndividual::yGen() {
 }
 
 Real RankISRIndividual::xGen(const RankVal& mu, Real pi) {
-#ifdef MC_DEBUG
-	int a = 0;
-	int g = 0;
-#endif
-
 #ifdef MC_DEBUG
 	std::cout << "RankISRIndividual::xGen, mu: " << mu << ", pi: " << pi << ", y_: " << itString(y_) << std::endl;
 #endif
 
-	Real logProba = 0.;
-
-	Real goodlp = std::log(pi);
-	Real badlp = std::log(1. - pi);
+	int a = 0; // the comparisons are counted, and the log-probability is computed at the end, as in lnCompletedProbability
+	int g = 0;
 
 	std::vector<int> x(1); // vector is suboptimal for insertion, but provides contiguous memory storage which will fit in CPU cache. std::list on the contrary does not guarantee contiguity.
 	x.reserve(nbPos_);
@@ -126,21 +235,12 @@ Real RankISRIndividual::xGen(const RankVal& mu, Real pi) {
 		for (int i = 0; i < j; ++i) {
 			bool comparison = mu.r()(currY) < mu.r()(x[i]); // true if curr elem is correctly ordered
 
+			++a;
 			if (multi_.sampleBinomial(pi) == 1) // is the comparison correct ?
 					{
-				logProba += goodlp;
-
-#ifdef MC_DEBUG
-				++a;
 				++g;
-#endif
 			} else {
 				comparison = !comparison;
-				logProba += badlp;
-
-#ifdef MC_DEBUG
-				++a;
-#endif
 			}
 
 			if (comparison) // element j must be placed here
@@ -161,7 +261,15 @@ Real RankISRIndividual::xGen(const RankVal& mu, Real pi) {
 	std::cout << "RankISRIndividual::xGen, a: " << a << ", g:" << g << std::endl;
 #endif
 
-	return lnFacNbPos_ + logProba;
+	Real logProba = lnFacNbPos_;
+	if (0 < g) { // the terms are only added if they have been sampled, so that pi = 0. or 1. gives a finite result
+		logProba += g * std::log(pi);
+	}
+	if (g < a) {
+		logProba += (a - g) * std::log(1. - pi);
+	}
+
+	return logProba;
 }
 
 Real RankISRIndividual::lnCompletedProbability(const RankVal& mu, Real pi, int& a,
@@ -172,12 +280,70 @@ Real RankISRIndividual::lnCompletedProbability(const RankVal& mu, Real pi, int&
 	std::cout << "RankISRIndividual::lnCompletedProbability, a: " << a << ", g:" << g << ", y_: " << itString(y_) << std::endl;
 #endif
 
-	return lnFacNbPos_ + g * std::log(pi) + (a - g) * std::log(1. - pi);
+	return lnCompletedProbability(a, g, pi);
 }
 
 void RankISRIndividual::AG(const RankVal& mu, int& a, int& g) const {
+	if (nbPos_ < nbPosInsertionAG) {
+		AGInsertion(mu, a, g);
+		return;
+	}
+
+	a = 0;
+	g = 0;
+
+	RankVal::ConstView xR = x_.r();
+	RankVal::ConstView muR = mu.r();
+
+	// Comparisons with the elements inserted before y_(j) and placed before it in x_. They all conclude that y_(j) is
+	// not before them, and are correct if mu also orders them before y_(j). The number of correct ones is obtained
+	// from counts of pairs of elements, see the computation of g below.
+
+	int nWord = PositionSet::nbWord(nbPos_);
+	std::vector<std::uint64_t> words(3 * nWord);
+	PositionSet insertedX(nbPos_, words.data()); // elements inserted, by position in x_
+	PositionSet insertedMu(nbPos_, words.data() + nWord); // elements inserted, by position in mu
+	long nAgreeYX = 0; // pairs ordered in the same way in y_ and x_
+	long nAgreeYMu = 0; // pairs ordered in the same way in y_ and mu
+	int maxX = -1; // last position in x_ of an inserted element
+
+	for (int j = 0; j < nbPos_; ++j) {
+		int currY = y_(j);
+		int nBefore = insertedX.countBefore(xR(currY));
+		nAgreeYX += nBefore;
+		nAgreeYMu += insertedMu.countBefore(muR(currY));
+		a += nBefore;
+
+		if (xR(currY) < maxX) { // last comparison, with the first inserted element after y_(j) in x_, which concludes that y_(j) is before it
+			++a;
+			int next = x_.o()(insertedX.next(xR(currY)));
+			if (muR(currY) < muR(next)) {
+				++g;
+			}
+		}
+
+		maxX = std::max(maxX, xR(currY));
+		insertedX.insert(xR(currY));
+		insertedMu.insert(muR(currY));
+	}
+
+	PositionSet insertedXMu(nbPos_, words.data() + 2 * nWord);
+	long nAgreeXMu = 0; // pairs ordered in the same way in x_ and mu
+	for (int p = 0; p < nbPos_; ++p) {
+		int currMod = x_.o()(p);
+		nAgreeXMu += insertedXMu.countBefore(muR(currMod));
+		insertedXMu.insert(muR(currMod));
+	}
+
+	// A pair contributes to g when it is ordered the same way in y_, x_ and mu. With P the number of pairs, and the
+	// pairs counted by their agreements, nAgreeXMu = 2 * nAgreeAll + P - nAgreeYX - nAgreeYMu.
+	long nPair = long(nbPos_) * (nbPos_ - 1) / 2;
+	g += (nAgreeXMu + nAgreeYX + nAgreeYMu - nPair) / 2;
+}
+
+void RankISRIndividual::AGInsertion(const RankVal& mu, int& a, int& g) const {
 #ifdef MC_DEBUG
-	std::cout << "RankISRIndividual::AG, y_: " << itString(y_) << ", mu.r(): " << itString(mu.r()) << ", x_.r(): " << itString(x_.r()) << std::endl;
+	std::cout << "RankISRIndividual::AGInsertion, y_: " << itString(y_) << ", mu.r(): " << itString(mu.r()) << ", x_.r(): " << itString(x_.r()) << std::endl;
 #endif
 
 	a = 0;
@@ -214,23 +380,138 @@ void RankISRIndividual::AG(const RankVal& mu, int& a, int& g) const {
 	}
 }
 
+void RankISRIndividual::deltaAGY(const RankVal& mu, int p, int& deltaA, int& deltaG) const {
+	int first = y_(p);
+	int second = y_(p + 1);
+
+	int aFirst, gFirst, aSecond, gSecond;
+	insertionAG(first, p, -1, mu, aFirst, gFirst); // current order
+	insertionAG(second, p, first, mu, aSecond, gSecond);
+	deltaA = -aFirst - aSecond;
+	deltaG = -gFirst - gSecond;
+
+	insertionAG(second, p, -1, mu, aSecond, gSecond); // permuted order
+	insertionAG(first, p, second, mu, aFirst, gFirst);
+	deltaA += aFirst + aSecond;
+	deltaG += gFirst + gSecond;
+}
+
+void RankISRIndividual::insertionAG(int e, int nbInserted, int other, const RankVal& mu, int& a, int& g) const {
+	RankVal::ConstView xR = x_.r();
+	RankVal::ConstView muR = mu.r();
+
+	a = 0;
+	g = 0;
+	int next = -1; // first inserted element after e in x_
+
+	for (int j = 0; j < nbInserted + 1; ++j) {
+		int curr = (j < nbInserted) ? y_(j) : other;
+		if (curr == -1) {
+			continue;
+		}
+
+		if (xR(curr) < xR(e)) {
+			++a;
+			if (muR(curr) < muR(e)) {
+				++g;
+			}
+		} else if (next == -1 || xR(curr) < xR(next)) {
+			next = curr;
+		}
+	}
+
+	if (next != -1) {
+		++a;
+		if (muR(e) < muR(next)) {
+			++g;
+		}
+	}
+}
+
+void RankISRIndividual::deltaAGX(const RankVal& mu, int p, int& deltaA, int& deltaG) const {
+	RankVal::ConstView xR = x_.r();
+	RankVal::ConstView muR = mu.r();
+	int first = x_.o()(p); // currently at position p, at position p + 1 after the permutation
+	int second = x_.o()(p + 1);
+
+	deltaA = 0;
+	deltaG = (muR(second) < muR(first)) ? 1 : -1; // the comparison of first and second agrees with mu either before or after the permutation
+
+	int maxBelow = -1; // last position before p of the inserted elements, first and second excluded
+	int minAbove = nbPos_; // first position after p + 1 of the inserted elements, first and second excluded
+	int nbPairInserted = 0;
+
+	for (int j = 0; j < nbPos_; ++j) {
+		int currY = y_(j);
+
+		if (currY == first || currY == second) {
+			++nbPairInserted;
+			if (nbPairInserted == 2 && minAbove < nbPos_) { // currY is compared to the other element of the pair, and to the first element after the pair only when it is after the other element in x_
+				int next = x_.o()(minAbove);
+				if (currY == second) { // second is after first before the permutation only
+					--deltaA;
+					if (muR(second) < muR(next)) {
+						--deltaG;
+					}
+				} else { // first is after second after the permutation only
+					++deltaA;
+					if (muR(first) < muR(next)) {
+						++deltaG;
+					}
+				}
+			}
+		} else if (xR(currY) < p) {
+			if (nbPairInserted == 2 && maxBelow < xR(currY)) { // the first inserted element after currY in x_ is first, and second after the permutation
+				deltaG += int(muR(currY) < muR(second)) - int(muR(currY) < muR(first));
+			}
+			maxBelow = std::max(maxBelow, xR(currY));
+		} else {
+			minAbove = std::min(minAbove, xR(currY));
+		}
+	}
+}
+
+void RankISRIndividual::comparisonCount(Matrix<int>& comparison) const {
+	RankVal::ConstView xR = x_.r();
+
+	for (int j = 0; j < nbPos_; ++j) {
+		int currY = y_(j);
+		int next = -1; // first inserted element after currY in x_
+
+		for (int i = 0; i < j; ++i) {
+			int prevY = y_(i);
+			if (xR(prevY) < xR(currY)) {
+				comparison(prevY, currY) += 1;
+			} else if (next == -1 || xR(prevY) < xR(next)) {
+				next = prevY;
+			}
+		}
+
+		if (next != -1) {
+			comparison(currY, next) += 1;
+		}
+	}
+}
+
 void RankISRIndividual::sampleX(const RankVal& mu, Real pi) {
-	int A, G; // dummy variables
+	int a, g;
 	Vector<Real, 2> logProba; // first element: current log proba, second element: logProba of permuted state
 	Vector<Real, 2> proba; // multinomial distribution obtained from the logProba
 
-	logProba(0) = lnCompletedProbability(mu, pi, A, G); // proba of current y
+	logProba(0) = lnCompletedProbability(mu, pi, a, g); // proba of current x
 
 	for (int p = 0; p < nbPos_ - 1; ++p) {
 		if (checkPermutation(p)) { // the main difference with sampleY is that here permutation only happens if they are authorized in the observed data
-			x_.permutation(p); // permutation is performed
-			logProba(1) = lnCompletedProbability(mu, pi, A, G); // proba is computed for alpha, and A and G are computed to check if the individual is valid
+			int deltaA, deltaG;
+			deltaAGX(mu, p, deltaA, deltaG);
+			logProba(1) = lnCompletedProbability(a + deltaA, g + deltaG, pi);
 
 			proba.logToMulti(logProba);
 			if (multi_.sample(proba) == 1) { // switch to permuted state ?
+				x_.permutation(p);
+				a += deltaA;
+				g += deltaG;
 				logProba(0) = logProba(1); // accept permutation
-			} else {
-				x_.permutation(p); // revert to previous state
 			}
 		}
 	}
@@ -241,21 +522,23 @@ void RankISRIndividual::sampleX(const RankVal& mu, Real pi) {
  * @param mu central rank
  * @param pi precision */
 void RankISRIndividual::sampleY(const RankVal& mu, Real pi) {
-	int A, G; // dummy variables
+	int a, g;
 	Vector<Real, 2> logProba; // first element: current log proba, second element: logProba of permuted state
 	Vector<Real, 2> proba; // multinomial distribution obtained from the logProba
 
-	logProba(0) = lnCompletedProbability(mu, pi, A, G); // proba of current y
+	logProba(0) = lnCompletedProbability(mu, pi, a, g); // proba of current y
 
 	for (int p = 0; p < nbPos_ - 1; ++p) {
-		permutationY(p);
-		logProba(1) = lnCompletedProbability(mu, pi, A, G);
+		int deltaA, deltaG;
+		deltaAGY(mu, p, deltaA, deltaG);
+		logProba(1) = lnCompletedProbability(a + deltaA, g + deltaG, pi);
 
 		proba.logToMulti(logProba);
 		if (multi_.sample(proba) == 1) { // switch to permuted state ?
+			permutationY(p);
+			a += deltaA;
+			g += deltaG;
 			logProba(0) = logProba(1); // accept permutation
-		} else {
-			permutationY(p); // revert to previous state
 		}
 	}
 }
@@ -317,24 +600,97 @@ void RankISRIndividual::recYgX(const RankVal& mu, Real pi,
 }
 
 void RankISRIndividual::observedProba(const RankVal& mu, Real pi,
-		std::map<RankVal, Real>& proba) {
+		std::unordered_map<RankVal, Real, RankValHash>& proba) {
 	proba.clear();
-	for (int i = 0; i < nbSampleObserved; ++i) {
-		yGen();
-		xGen(mu, pi);
-		proba[x_] += 1.;
+	int nbSample = 0;
+	while (true) {
+		for (int i = 0; i < nbSampleObserved; ++i) {
+			yGen();
+			xGen(mu, pi);
+			proba[x_] += 1.;
+		}
+		nbSample += nbSampleObserved;
+
+		int nbSingleton = 0;
+		for (std::unordered_map<RankVal, Real, RankValHash>::const_iterator it =
+				proba.begin(), itEnd = proba.end(); it != itEnd; ++it) {
+			if (it->second == 1.) {
+				++nbSingleton;
+			}
+		}
 
 #ifdef MC_DEBUG
-		std::cout << "RankIndividual::observedProba, i: " << i << ", x_: " << x_ << std::endl;
+		std::cout << "RankIndividual::observedProba, nbSample: " << nbSample << ", proba.size(): " << proba.size() << ", nbSingleton: " << nbSingleton << std::endl;
 #endif
+
+		if (Real(nbSingleton) < unseenMassRank * nbSample || nbSampleObservedRankMax <= nbSample) {
+			break;
+		}
 	}
 
-	for (std::map<RankVal, Real>::iterator it = proba.begin(), itEnd =
-			proba.end(); it != itEnd; ++it) {
-		it->second /= Real(nbSampleObserved);
+	for (std::unordered_map<RankVal, Real, RankValHash>::iterator it =
+			proba.begin(), itEnd = proba.end(); it != itEnd; ++it) {
+		it->second /= Real(nbSample);
 	}
 }
 
+Real RankISRIndividual::lnMarginalProbability(const RankVal& x,
+		const RankVal& mu, Real pi) {
+	int nbPos = x.nbPos();
+	unsigned int nbSubset = 1u << nbPos;
+
+	std::vector<unsigned int> agreeBefore(nbPos, 0); // bit p of agreeBefore[q], p < q, is set if mu orders x.o()(p) before x.o()(q), as x does
+	for (int q = 0; q < nbPos; ++q) {
+		for (int p = 0; p < q; ++p) {
+			if (mu.r()(x.o()(p)) < mu.r()(x.o()(q))) {
+				agreeBefore[q] |= 1u << p;
+			}
+		}
+	}
+
+	std::vector<Real> powPi(nbPos + 1); // a step has at most nbPos comparisons
+	std::vector<Real> powBad(nbPos + 1);
+	powPi[0] = 1.;
+	powBad[0] = 1.;
+	for (int c = 1; c <= nbPos; ++c) {
+		powPi[c] = powPi[c - 1] * pi;
+		powBad[c] = powBad[c - 1] * (1. - pi);
+	}
+
+	std::vector<Real> proba(nbSubset, 0.); // proba[S]: sum over the orders of insertion of the positions in S of the probability of the comparisons
+	proba[0] = 1.;
+
+	for (unsigned int s = 0; s < nbSubset; ++s) {
+		if (proba[s] == 0.) {
+			continue;
+		}
+
+		for (int q = 0; q < nbPos; ++q) { // insertion of position q, the elements of s are sorted as in x
+			unsigned int bitQ = 1u << q;
+			if (s & bitQ) {
+				continue;
+			}
+
+			unsigned int before = s & (bitQ - 1); // compared to x.o()(q) and kept before it
+			int a = std::bitset<32>(before).count();
+			int g = std::bitset<32>(before & agreeBefore[q]).count();
+
+			unsigned int after = s & ~(bitQ | (bitQ - 1));
+			if (after != 0) { // x.o()(q) is inserted before the first element of s after it
+				unsigned int bitNext = after & (~after + 1);
+				++a;
+				if (agreeBefore[std::bitset<32>(bitNext - 1).count()] & bitQ) {
+					++g;
+				}
+			}
+
+			proba[s | bitQ] += proba[s] * powPi[g] * powBad[a - g];
+		}
+	}
+
+	return std::log(proba[nbSubset - 1]) - std::log(fac(nbPos));
+}
+
 bool RankISRIndividual::checkMissingType(const Vector<bool>& acceptedType) const {
 	for (int p = 0; p < nbPos_; ++p) {
 		if (acceptedType(obsData_(p).first) == false) {
@@ -345,97 +701,108 @@ bool RankISRIndividual::checkMissingType(const Vector<bool>& acceptedType) const
 	return true;
 }
 
-std::list<int> RankISRIndividual::candidateList(int currPos,
-		const std::set<int>& remainingMod) const {
-	std::list<int> candidateList;
-
-	if (obsData_(currPos).first == present_) { // if data is present
-		if (remainingMod.find(x_.o()(currPos)) != remainingMod.end()) { // only add the observed value if it is still available, to avoid duplication of value in completed individual
-#ifdef MC_DEBUG
-				std::cout << "RankISRIndividual::candidateList, present_, x_.o(): " << itString(x_.o()) << std::endl;
-#endif
+bool RankISRIndividual::reservePresent(std::vector<bool>& used) const {
+	used.assign(nbPos_, false);
 
-			candidateList.push_back(x_.o()(currPos));
-		}
-	} else if (obsData_(currPos).first == missing_) { // since value is unobserved, all candidates can be considered
-		for (std::set<int>::const_iterator it = remainingMod.begin(), itE =
-				remainingMod.end(); it != itE; ++it) {
-			candidateList.push_back(*it);
+	for (int p = 0; p < nbPos_; ++p) {
+		if (obsData_(p).first == present_) {
+			int m = x_.o()(p);
+			if (used[m]) {
+				return false;
+			}
+			used[m] = true;
 		}
-	} else if (obsData_(currPos).first == missingFiniteValues_) { // only add the intersection between what is possible and what is available
-#ifdef MC_DEBUG
-			std::cout << "RankISRIndividual::candidateList, missingFiniteValues_, obsData_(currPos).second: " << itString(obsData_(currPos).second) << std::endl;
-#endif
+	}
 
-		std::set_intersection(
-				remainingMod.begin(), // compute the intersection between the remainingMod and the currently possible missing value
-				remainingMod.end(), obsData_(currPos).second.begin(),
-				obsData_(currPos).second.end(),
-				std::back_inserter(candidateList));
+	return true;
+}
+
+void RankISRIndividual::forEachCompleted(const std::function<void(const RankVal&)>& f) const {
+	std::vector<bool> used;
+	if (!reservePresent(used)) {
+		return;
 	}
 
-	return candidateList;
+	Vector<int> completedVec(nbPos_);
+	RankVal rv(nbPos_);
+	recForEachCompleted(0, used, completedVec, rv, f);
 }
 
-std::list<RankVal> RankISRIndividual::recEnumComplete(int currPos,
-		const std::set<int>& remainingMod,
-		const Vector<int>& completedVec) const {
-#ifdef MC_DEBUG
-	std::cout << "RankISRIndividual::recEnumComplete, currPos: " << currPos << ", "
-	<< "remainingMod: " << itString(remainingMod) << ", "
-	<< "completedVec: " << itString(completedVec) << std::endl;
-#endif
+void RankISRIndividual::recForEachCompleted(int currPos, std::vector<bool>& used, Vector<int>& completedVec, RankVal& rv,
+		const std::function<void(const RankVal&)>& f) const {
+	if (currPos == nbPos_) { // termination condition of the recursion
+		rv.setO(completedVec);
+		f(rv);
+		return;
+	}
 
-	std::list<RankVal> rankList;
+	if (obsData_(currPos).first == present_) { // its modality has been reserved
+		completedVec(currPos) = x_.o()(currPos);
+		recForEachCompleted(currPos + 1, used, completedVec, rv, f);
+		return;
+	}
 
-	if (currPos != nbPos_) { // recursive calls remain
-		std::list<int> cl = candidateList(currPos, // compute the list of possible modalities for the current position, considering the observation
-				remainingMod);
+	for (int c = 0, nbCand = nbCandidate(currPos); c < nbCand; ++c) { // the candidates are sorted
+		int m = candidate(currPos, c);
+		if (used[m]) {
+			continue;
+		}
 
-#ifdef MC_DEBUG
-		std::cout << "cl.size(): " << cl.size() << std::endl;
-#endif
+		used[m] = true;
+		completedVec(currPos) = m;
+		recForEachCompleted(currPos + 1, used, completedVec, rv, f);
+		used[m] = false;
+	}
+}
 
-		for (std::list<int>::const_iterator it = cl.begin(), itE = cl.end();
-				it != itE; ++it) {
-#ifdef MC_DEBUG
-			std::cout << "cl, *it: " << *it << std::endl;
-#endif
+Real RankISRIndividual::nbCompleted() const {
+	std::vector<bool> used;
+	if (!reservePresent(used)) {
+		return 0.;
+	}
 
-			std::set<int> subRemainingMod = remainingMod;
-			subRemainingMod.erase(*it);
-			Vector<int> subCompletedVec = completedVec;
-			subCompletedVec(currPos) = *it;
+	return nbCompleted(0, used);
+}
 
-			rankList.merge(
-					recEnumComplete(currPos + 1, subRemainingMod,
-							subCompletedVec));
+Real RankISRIndividual::nbCompleted(int firstPos, std::vector<bool>& used) const {
+	Real nbMissingOrder = 1.; // number of orders of the modalities left to the missing positions
+	for (int p = firstPos, nbMissing = 0; p < nbPos_; ++p) {
+		if (obsData_(p).first == missing_) {
+			++nbMissing;
+			nbMissingOrder *= nbMissing;
 		}
-	} else { // termination condition of the recursion
-#ifdef MC_DEBUG
-	std::cout << "RankISRIndividual::recEnumComplete, termination" << std::endl;
-#endif
-
-		RankVal rv(nbPos_);
-		rv.setO(completedVec);
-		rankList.push_back(rv);
 	}
 
-	return rankList;
+	return nbMissingOrder * nbFiniteValuesAssignment(firstPos, used);
 }
 
-std::list<RankVal> RankISRIndividual::enumCompleted() const {
-	std::list<RankVal> rankList;
-	std::set<int> remainingMod;
-	Vector<int> completedVec(nbPos_, -1);
+Real RankISRIndividual::nbFiniteValuesAssignment(int currPos, std::vector<bool>& used) const {
+	while (currPos < nbPos_ && obsData_(currPos).first != missingFiniteValues_) {
+		++currPos;
+	}
+
+	if (currPos == nbPos_) {
+		return 1.;
+	}
 
-	for (int i = 0; i < nbPos_; ++i) {
-		remainingMod.insert(i);
+	Real nbAssignment = 0.;
+	for (int c = 0, nbCand = nbCandidate(currPos); c < nbCand; ++c) {
+		int m = candidate(currPos, c);
+		if (!used[m]) {
+			used[m] = true;
+			nbAssignment += nbFiniteValuesAssignment(currPos + 1, used);
+			used[m] = false;
+		}
 	}
 
-	rankList = recEnumComplete(0, // currPos
-			remainingMod, // remaining mod
-			completedVec); // completedVec
+	return nbAssignment;
+}
+
+std::list<RankVal> RankISRIndividual::enumCompleted() const {
+	std::list<RankVal> rankList;
+	forEachCompleted([&rankList](const RankVal& rv) {
+		rankList.push_back(rv);
+	});
 
 	return rankList;
 }
@@ -23,9 +23,12 @@
 #ifndef RANKISRINDIVIDUAL_H
 #define RANKISRINDIVIDUAL_H
 
+#include <functional>
 #include <list>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include <LinAlg/LinAlg.h>
 #include <Mixture/Rank/RankVal.h>
@@ -73,6 +76,11 @@ public:
 		return y_;
 	}
 
+	/** Get the presentation order, for example for debugging purposes */
+	Vector<int>& yModif() {
+		return y_;
+	}
+
 	/** Set the number of positions in the rank, used to resize storage */
 	void setNbPos(int nbPos);
 
@@ -125,8 +133,43 @@ public:
 	 * */
 	Real xGen(const RankVal& mu, Real pi);
 
+	/**
+	 * Number of comparisons a, and of correct comparisons g according to mu, made by the insertion sort that builds x_
+	 * from the presentation order y_. Each element is compared to the elements already inserted that are before it in
+	 * x_, then to the first one after it, if any. Hence the comparisons are counted with rank and select queries on
+	 * the set of inserted positions, a bit vector, instead of replaying the insertion sort, see AGInsertion. This is
+	 * O(nbPos * nbPos / 64) word operations, that is linear in nbPos for ranks of up to a few hundred positions. Below
+	 * nbPosInsertionAG positions, replaying the insertion sort is faster and AGInsertion is called.
+	 */
 	void AG(const RankVal& mu, int& a, int& g) const;
 
+	/** Reference implementation of AG, in O(nbPos^2), which replays the insertion sort. Kept for tests and benchmarks. */
+	void AGInsertion(const RankVal& mu, int& a, int& g) const;
+
+	/**
+	 * Variation of a and g, see AG, if y_(p) and y_(p + 1) were permuted. Only the insertions of these two elements are
+	 * modified, hence the variation is computed from the elements inserted before them, in O(p). This is used by
+	 * sampleY instead of a call to AG per proposed permutation.
+	 */
+	void deltaAGY(const RankVal& mu, int p, int& deltaA, int& deltaG) const;
+
+	/**
+	 * Variation of a and g, see AG, if the elements at positions p and p + 1 of x_ were permuted. The two elements are
+	 * compared in both cases, and the correctness of this comparison is reversed. The other comparisons that change are
+	 * the comparison of the one inserted last with the first element after the pair in x_, and the comparisons of the
+	 * elements inserted after both of them whose first inserted element after them in x_ is one of them. They are found
+	 * in a single pass on y_, in O(nbPos). This is used by sampleX instead of a call to AG per proposed permutation.
+	 */
+	void deltaAGX(const RankVal& mu, int p, int& deltaA, int& deltaG) const;
+
+	/**
+	 * Add the comparisons made by the insertion sort to comparison, where comparison(e, f) is incremented each time the
+	 * elements e and f are compared, e being before f in x_. The outcome of a comparison is always the order of the two
+	 * elements in x_, hence the comparisons do not depend on mu: a is the sum of comparison, and g is the sum of the
+	 * comparison(e, f) for which mu also orders e before f. In O(nbPos^2).
+	 */
+	void comparisonCount(Matrix<int>& comparison) const;
+
 	void probaYgX(const RankVal& mu, Real pi, Vector<Vector<int> >& resVec,
 			Vector<Real>& resProba);
 
@@ -138,34 +181,44 @@ public:
 			const std::set<int>& remainingMod, int firstElem, int nbElem,
 			int currPos, int nbPos);
 
-	/** Compute the observed probability distribution for mu and pi, by generating nbSampleObserved
-	 * independent observations and marginalizing over presentation order. This procedure is similar
-	 * to what is used in the Ordinal model, and in contrast with the use of the harmonic mean estimator
-	 * of the observed probability. */
+	/** Estimate the observed probability distribution for mu and pi, by generating independent observations
+	 * and marginalizing over presentation order. This procedure is similar to what is used in the Ordinal
+	 * model, and in contrast with the use of the harmonic mean estimator of the observed probability.
+	 * Observations are generated by batches of nbSampleObserved, until the Good-Turing estimate of the
+	 * probability of the rankings not generated yet (proportion of rankings generated only once) is below
+	 * unseenMassRank, or nbSampleObservedRankMax observations have been generated. */
 	void observedProba(const RankVal& mu, Real pi,
-			std::map<RankVal, Real>& proba);
+			std::unordered_map<RankVal, Real, RankValHash>& proba);
+
+	/** Exact log-probability of x for mu and pi, marginalized over the presentation order. For a given x, the
+	 * comparisons made when an element is inserted only depend on the set of elements already inserted, hence
+	 * the sum over the nbPos! presentation orders is a dynamic programme over the 2^nbPos subsets of positions of
+	 * x, in O(2^nbPos nbPos). It is used up to nbPosExactRank positions. */
+	static Real lnMarginalProbability(const RankVal& x, const RankVal& mu, Real pi);
 
 	bool checkMissingType(const Vector<bool>& acceptedType) const;
 
-	/** Provide a list of possible values for a position considering the observed value and the set of
-	 * possible values remaining. */
-	std::list<int> candidateList(int currPos,
-			const std::set<int>& remainingMod) const;
-
-	/** Recursive function called by enumAllCompleted.
-	 *
-	 * @param currPos current position in the rank
-	 * @param remainingMod set of modalities that have not yet been seen in the rank
-	 * @param completedVec the completed rank from which recEnumComplete was called (complement remainingMod)
-	 * @return The list of all the possible RankVal enumerated in sub calls */
-	std::list<RankVal> recEnumComplete(int currPos,
-			const std::set<int>& remainingMod,
-			const Vector<int>& completedVec) const;
+	/**
+	 * Call f on each completion of the individual compatible with obsData_, in the lexicographic order of the
+	 * orderings, without storing them. The RankVal passed to f is reused between the calls. The modalities of the
+	 * present positions are reserved from the start, so that the branches which would give them to another position are
+	 * not explored.
+	 */
+	void forEachCompleted(const std::function<void(const RankVal&)>& f) const;
+
+	/**
+	 * Number of completions of the individual compatible with obsData_, computed without enumerating them. The missing
+	 * positions take the modalities left by the others in any order, hence only the assignments of the positions with
+	 * missing finite values are enumerated. The result is a Real since it grows factorially with the number of missing
+	 * positions.
+	 */
+	Real nbCompleted() const;
 
 	/** Use the obsData_ information to compute all the possible completions for the individual. If there is no
 	 * partially observed data, the method still is useful at providing a check of the observed individual. For
 	 * a valid individual, the returned list must have at least one element, which is a copy of x_, otherwise,
-	 * data is invalid, for example in the case 1,1,3. */
+	 * data is invalid, for example in the case 1,1,3. The completions are stored, see forEachCompleted and
+	 * nbCompleted to avoid it. */
 	std::list<RankVal> enumCompleted() const;
 
 	/** Is the individual completely observed ? This is used to determine if statistics for a partially observed
@@ -186,6 +239,51 @@ private:
 	/** Permute the elements firstElem and firstElem + 1 in y_ */
 	void permutationY(int firstElem);
 
+	/** Completed log-probability for a and g computed by AG */
+	Real lnCompletedProbability(int a, int g, Real pi) const {
+		return lnFacNbPos_ + g * std::log(pi) + (a - g) * std::log(1. - pi);
+	}
+
+	/**
+	 * Number of comparisons a, and of correct comparisons g, made when e is inserted among y_(0), ..., y_(nbInserted - 1)
+	 * and other, which is ignored if it is -1.
+	 */
+	void insertionAG(int e, int nbInserted, int other, const RankVal& mu, int& a, int& g) const;
+
+	/**
+	 * Mark the modalities of the present positions as used
+	 * @return false if a modality is present twice, in which case the individual has no completion
+	 */
+	bool reservePresent(std::vector<bool>& used) const;
+
+	/** Number of modalities a position which is not present can take according to obsData_, used ones included */
+	int nbCandidate(int pos) const {
+		return (obsData_(pos).first == missing_) ? nbPos_ : obsData_(pos).second.size();
+	}
+
+	/** Modality c among the nbCandidate(pos) ones of a position which is not present */
+	int candidate(int pos, int c) const {
+		return (obsData_(pos).first == missing_) ? c : obsData_(pos).second[c];
+	}
+
+	/** Recursive function called by forEachCompleted, that completes the positions from currPos */
+	void recForEachCompleted(int currPos, std::vector<bool>& used, Vector<int>& completedVec, RankVal& rv,
+			const std::function<void(const RankVal&)>& f) const;
+
+	/** Number of completions of the positions from firstPos, the modalities in used being excluded */
+	Real nbCompleted(int firstPos, std::vector<bool>& used) const;
+
+	/** Number of ways to give distinct modalities, not in used, to the positions with missing finite values from currPos */
+	Real nbFiniteValuesAssignment(int currPos, std::vector<bool>& used) const;
+
+	/**
+	 * Uniform sampling of x_ among the completions. The index of the completion is sampled, then each position receives
+	 * the first candidate whose number of completions of the next positions exceeds the remaining index. This selects
+	 * the same completion as an enumeration of them in lexicographic order, without the enumeration. When the number of
+	 * completions does not fit in an int, each position is sampled in turn proportionally to these numbers instead.
+	 */
+	void sampleCompleted();
+
 	/** Is a value authorized for a particular MisVal describing */
 	bool isAuthorized(int value, const MisVal& misval) const;
 
@@ -23,7 +23,6 @@
 #ifndef LIB_MIXTURE_RANK_RANKISRMIXTURE_H
 #define LIB_MIXTURE_RANK_RANKISRMIXTURE_H
 
-#include <set>
 #include <vector>
 #include <utility>
 #include <Data/ConfIntDataStat.h>
@@ -45,9 +44,9 @@ class RankISRMixture: public IMixture {
 public:
 	typedef std::pair<MisType, std::vector<int> > MisVal;
 
-	RankISRMixture(const Graph& data, const Graph& param, Graph& out, std::string const& idName, Index nClass, Index nObs, Real confidenceLevel, const std::string& paramStr) :
+	RankISRMixture(const Graph& data, const Graph& param, Graph& out, std::string const& idName, Index nClass, Index nObs, Real confidenceLevel, ParamStatMode paramStatMode, const std::string& paramStr) :
 			IMixture(idName, "Rank_ISR", nClass, nObs), nbPos_(0), facNbMod_(0.), confidenceLevel_(confidenceLevel), dataG_(data), paramG_(param), outG_(out), mu_(nClass), pi_(nClass), piParamStat_(
-					pi_, confidenceLevel) {
+					pi_, confidenceLevel, paramStatMode) {
 		class_.reserve(nClass);
 		muParamStat_.reserve(nClass);
 		for (int k = 0; k < nClass; ++k) {
@@ -70,7 +69,7 @@ public:
 	}
 
 	/** Note that MixtureComposer::checkNbIndPerClass already enforce that there is at least one observation per class, in order to properly estimate the proportions. */
-	std::string checkSampleCondition(const Vector<std::set<Index> >& classInd) const {
+	std::string checkSampleCondition(const Vector<std::vector<Index>>& classInd) const {
 		if (degeneracyAuthorizedForNonBoundedLikelihood)
 			return "";
 
@@ -78,7 +77,7 @@ public:
 			bool Geq0 = true; // are all comparisons incorrect ? This would lead to pi = 1 in a maximum likelihood estimation and is to be avoided.
 			bool GeqA = true; // are all comparisons correct ? This would lead to pi = 1 in a maximum likelihood estimation and is to be avoided.
 
-			for (std::set<Index>::const_iterator it = classInd(k).begin(), itE = classInd(k).end(); it != itE; ++it) {
+			for (std::vector<Index>::const_iterator it = classInd(k).begin(), itE = classInd(k).end(); it != itE; ++it) {
 				int A, G;
 				data_(*it).AG(mu_(k), A, G);
 				if (A == 0) {
@@ -112,14 +111,20 @@ public:
 	 * of the parameters is only here to ensure that all individuals are valid (not all z at 0). In the Rank model initialization, mu is chosen among all the
 	 * observed values of the class, while pi is initialized to a "neutral" value.
 	 * */
-	std::string mStep(const Vector<std::set<Index> >& classInd) {
-		for (int k = 0; k < nClass_; ++k) {
-			class_[k].mStep(classInd(k));
-		}
+	std::string mStep(const Vector<std::vector<Index>>& classInd, Index k) {
+		class_[k].mStep(classInd(k));
 
 		return "";
 	}
 
+	/**
+	 * Each Gibbs iteration tries every transposition of adjacent positions of mu, and each trial evaluates the completed
+	 * probability of all the individuals of the class.
+	 */
+	Real mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const {
+		return Real(classInd(k).size()) * nbGibbsIterRankMStep * nbPos_ * nbPos_;
+	}
+
 	void storeSEMRun(Index iteration, Index iterationMax) {
 		for (int k = 0; k < nClass_; ++k) {
 			muParamStat_[k].sampleValue(iteration, iterationMax);
@@ -153,6 +158,14 @@ public:
 		return class_[k].lnObservedProbability(i);
 	}
 
+	void lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+		for (Index k = 0; k < nClass_; ++k) {
+			for (Index i = iBegin; i < iEnd; ++i) {
+				lnProba(i - iBegin, k) += class_[k].lnCompletedProbabilityInd(i);
+			}
+		}
+	}
+
 	void initData(Index i) {
 		data_(i).removeMissing();
 	}
@@ -207,61 +220,15 @@ public:
 			return warnLog;
 		}
 
-		if (mode == prediction_) { // prediction mode
-			paramG_.get_payload( { idName_ }, "paramStr", paramStr_); // overwrite paramStr_ obtained from desc
-
-			for (Index k = 0; k < nClass_; ++k) {
-				NamedMatrix<int> rank;
-				paramG_.get_payload( { idName_, "mu", "stat", "k: " + std::to_string(k + minModality) }, "rank", rank);
-				rank.mat_ -= minModality;
-				mu_(k).setNbPos(rank.mat_.cols());
-				mu_(k).setO(rank.mat_.row(0)); // the most probable rank has been written in the first line of the rank matrix
-			}
-
-			NamedMatrix<Real> pi;
-			paramG_.get_payload( { idName_, "pi" }, "stat", pi);
-			pi_ = pi.mat_.col(0); // the two other columns are dedicated to quantiles
-
-			for (int k = 0; k < nClass_; ++k) {
-				muParamStat_[k].setParamStorage();
-			}
-			piParamStat_.setParamStorage();
-		}
-
-		if (paramStr_.size() == 0) { // if paramStr_ not provided, must be generated from the data, for future use and export for prediction
-			std::stringstream sstm;
-			sstm << "nModality: " << nbPos_;
-			paramStr_ = sstm.str();
-		} else {
-			int nPosStr = -1;
-
-			std::string nModStr = std::string("nModality: *") + strPositiveInteger; // parse paramStr here. If empty, deduce from data, if not empty, check that data UPPER BOUND is compatible with this information
-			std::regex nModRe(nModStr);
-			std::smatch matchesVal;
-
-			if (std::regex_match(paramStr_, matchesVal, nModRe)) { // value is present
-				nPosStr = str2type<int>(matchesVal[1].str());
-			} else {
-				std::stringstream sstm;
-				sstm << "Variable: " << idName_ << " parameter string is not in the correct format, which should be \"nModality: x\" " << "with x the number of modalities in the variable."
-						<< std::endl;
-				warnLog += sstm.str();
-			}
-
-			if (nbPos_ != nPosStr) {
-				std::stringstream sstm;
-				sstm << "Variable: " << idName_ << " has " << nPosStr << " modalities per rank in its descriptor (or the descriptor from learning, in case of prediction) " << "but has " << nbPos_
-						<< " modalities in its data. Those two numbers must be equal." << std::endl;
-				warnLog += sstm.str();
-			}
-		}
+		return setParsedDataParam(mode);
+	}
 
-		dataStat_.reserve(nInd_);
-		for (int i = 0; i < nInd_; ++i) {
-			dataStat_.emplace_back(data_(i).xModif(), confidenceLevel_);
-		}
+	std::string setDataParam(RunMode mode, const IMixture& source) {
+		const RankISRMixture& sourceRank = static_cast<const RankISRMixture&>(source);
+		nbPos_ = sourceRank.nbPos_;
+		data_ = sourceRank.data_;
 
-		return warnLog;
+		return setParsedDataParam(mode);
 	}
 
 	void exportDataParam() const {
@@ -353,9 +320,70 @@ public:
 	}
 
 	bool sampleApproximationOfObservedProba() {
-		return true;
+		return nbPosExactRank < nbPos_; // otherwise the observed probability is exact, see RankISRClass::computeObservedProba
 	}
 private:
+	/** End of setDataParam, once nbPos_ and data_ have been filled and checked. */
+	std::string setParsedDataParam(RunMode mode) {
+		std::string warnLog;
+
+		if (mode == prediction_) { // prediction mode
+			paramG_.get_payload( { idName_ }, "paramStr", paramStr_); // overwrite paramStr_ obtained from desc
+
+			for (Index k = 0; k < nClass_; ++k) {
+				NamedMatrix<int> rank;
+				paramG_.get_payload( { idName_, "mu", "stat", "k: " + std::to_string(k + minModality) }, "rank", rank);
+				rank.mat_ -= minModality;
+				mu_(k).setNbPos(rank.mat_.cols());
+				mu_(k).setO(rank.mat_.row(0)); // the most probable rank has been written in the first line of the rank matrix
+			}
+
+			NamedMatrix<Real> pi;
+			paramG_.get_payload( { idName_, "pi" }, "stat", pi);
+			pi_ = pi.mat_.col(0); // the two other columns are dedicated to quantiles
+
+			for (int k = 0; k < nClass_; ++k) {
+				muParamStat_[k].setParamStorage();
+			}
+			piParamStat_.setParamStorage();
+		}
+
+		if (paramStr_.size() == 0) { // if paramStr_ not provided, must be generated from the data, for future use and export for prediction
+			std::stringstream sstm;
+			sstm << "nModality: " << nbPos_;
+			paramStr_ = sstm.str();
+		} else {
+			int nPosStr = -1;
+
+			std::string nModStr = std::string("nModality: *") + strPositiveInteger; // parse paramStr here. If empty, deduce from data, if not empty, check that data UPPER BOUND is compatible with this information
+			std::regex nModRe(nModStr);
+			std::smatch matchesVal;
+
+			if (std::regex_match(paramStr_, matchesVal, nModRe)) { // value is present
+				nPosStr = str2type<int>(matchesVal[1].str());
+			} else {
+				std::stringstream sstm;
+				sstm << "Variable: " << idName_ << " parameter string is not in the correct format, which should be \"nModality: x\" " << "with x the number of modalities in the variable."
+						<< std::endl;
+				warnLog += sstm.str();
+			}
+
+			if (nbPos_ != nPosStr) {
+				std::stringstream sstm;
+				sstm << "Variable: " << idName_ << " has " << nPosStr << " modalities per rank in its descriptor (or the descriptor from learning, in case of prediction) " << "but has " << nbPos_
+						<< " modalities in its data. Those two numbers must be equal." << std::endl;
+				warnLog += sstm.str();
+			}
+		}
+
+		dataStat_.reserve(nInd_);
+		for (int i = 0; i < nInd_; ++i) {
+			dataStat_.emplace_back(data_(i).xModif(), confidenceLevel_);
+		}
+
+		return warnLog;
+	}
+
 	std::string checkMissingType() {
 		std::string warnLog;
 
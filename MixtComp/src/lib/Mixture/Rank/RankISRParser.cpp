@@ -118,7 +118,7 @@ std::string parseRankStr(const std::vector<std::string>& vecStr, int minMod, int
 		vecInd(i).setO(o);
 		vecInd(i).setObsData(obsData);
 
-		if (vecInd(i).enumCompleted().size() == 0) {
+		if (vecInd(i).nbCompleted() == 0.) {
 #ifdef MC_DEBUG
 			std::cout << "o: " << itString(o) << std::endl;
 			std::cout << "obsData: " << std::endl;
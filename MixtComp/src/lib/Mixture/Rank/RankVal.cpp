@@ -20,6 +20,9 @@
  *  Authors:    Vincent KUBICKI <vincent.kubicki@inria.fr>
  **/
 
+#include <algorithm>
+#include <sstream>
+
 #include <Mixture/Rank/RankVal.h>
 
 namespace mixt {
@@ -28,73 +31,127 @@ RankVal::RankVal() :
 }
 
 RankVal::RankVal(int nbPos) :
-		nbPos_(nbPos) {
-	ordering_.resize(nbPos);
-	ranking_.resize(nbPos);
+		nbPos_(0) {
+	setNbPos(nbPos);
 }
 
-void RankVal::operator=(const RankVal& rv) {
-	nbPos_ = rv.nbPos_;
-	ordering_ = rv.ordering_;
-	ranking_ = rv.ranking_;
+RankVal::RankVal(const std::initializer_list<int>& il) :
+		nbPos_(0) {
+	setNbPos(il.size());
+	setO(il);
+}
+
+RankVal::RankVal(const RankVal& rv) :
+		nbPos_(0) {
+	*this = rv;
+}
+
+RankVal::RankVal(RankVal&& rv) :
+		nbPos_(0) {
+	*this = std::move(rv);
 }
 
-RankVal::RankVal(const std::initializer_list<int>& il) {
-	nbPos_ = il.size();
-	ordering_.resize(nbPos_);
-	ranking_.resize(nbPos_);
+RankVal& RankVal::operator=(const RankVal& rv) {
+	if (this != &rv) {
+		if (nbPos_ != rv.nbPos_) {
+			setNbPos(rv.nbPos_);
+		}
+		std::copy(rv.data(), rv.data() + 2 * nbPos_, data());
+	}
 
-	int i = 0;
-	for (std::initializer_list<int>::const_iterator it = il.begin(), itEnd =
-			il.end(); it != itEnd; ++it, ++i) {
-		ordering_(i) = *it;
+	return *this;
+}
+
+RankVal& RankVal::operator=(RankVal&& rv) {
+	if (rv.nbPos_ <= nbPosInline) { // nothing to steal
+		return *this = rv;
 	}
 
-	switchRepresentation(ordering_, ranking_);
+	nbPos_ = rv.nbPos_;
+	heap_ = std::move(rv.heap_);
+	rv.nbPos_ = 0;
+
+	return *this;
 }
 
 bool RankVal::operator==(const RankVal& rv) const {
-	if (rv.ordering_ == ordering_) {
-		return true;
-	} else {
-		return false;
-	}
+	return nbPos_ == rv.nbPos_ && std::equal(dataO(), dataO() + nbPos_, rv.dataO());
 }
 
 bool RankVal::operator<(const RankVal& rv) const {
-	return (ordering_ < rv.ordering_);
+	return std::lexicographical_compare(dataO(), dataO() + nbPos_, rv.dataO(), rv.dataO() + rv.nbPos_);
 }
 
 void RankVal::setNbPos(int nbPos) {
 	nbPos_ = nbPos;
-	ordering_.resize(nbPos);
-	ranking_.resize(nbPos);
+	if (nbPosInline < nbPos) {
+		heap_.reset(new int[2 * nbPos]);
+	} else {
+		heap_.reset();
+	}
 }
 
 void RankVal::switchRepresentation(const Vector<int>& mu,
 		Vector<int>& muP) const {
-	for (int p = 0; p < nbPos_; ++p) {
-		muP(mu(p)) = p;
+	switchRepresentation(mu.data(), muP.data(), nbPos_);
+}
+
+void RankVal::switchRepresentation(const int* mu, int* muP, int nbPos) {
+	for (int p = 0; p < nbPos; ++p) {
+		muP[mu[p]] = p;
 	}
 }
 
 void RankVal::permutation(int firstElem) {
-	int dummyO = ordering_(firstElem);
-	int dummyR = ranking_(ordering_(firstElem));
+	int* ordering = dataO();
+	int* ranking = dataR();
 
-	ranking_(ordering_(firstElem)) = ranking_(ordering_(firstElem + 1));
-	ranking_(ordering_(firstElem + 1)) = dummyR;
+	std::swap(ranking[ordering[firstElem]], ranking[ordering[firstElem + 1]]);
+	std::swap(ordering[firstElem], ordering[firstElem + 1]);
+}
 
-	ordering_(firstElem) = ordering_(firstElem + 1);
-	ordering_(firstElem + 1) = dummyO;
+std::uint64_t RankVal::index() const {
+	const int* ordering = dataO();
+	std::uint64_t res = 0;
+
+	for (int i = 0; i < nbPos_; ++i) { // Horner scheme on the factorial number system
+		int nbSmallerAfter = 0;
+		for (int j = i + 1; j < nbPos_; ++j) {
+			if (ordering[j] < ordering[i]) {
+				++nbSmallerAfter;
+			}
+		}
+		res = res * (nbPos_ - i) + nbSmallerAfter;
+	}
+
+	return res;
+}
+
+void RankVal::setIndex(std::uint64_t index) {
+	int* ordering = dataO();
+
+	for (int i = nbPos_ - 1; 0 <= i; --i) { // digits of the Lehmer code, from the last position
+		ordering[i] = index % (nbPos_ - i);
+		index /= (nbPos_ - i);
+	}
+
+	for (int i = nbPos_ - 1; 0 <= i; --i) { // the digit of position i is its order among the modalities of positions i to nbPos_ - 1
+		for (int j = i + 1; j < nbPos_; ++j) {
+			if (ordering[i] <= ordering[j]) {
+				++ordering[j];
+			}
+		}
+	}
+
+	switchRepresentation(dataO(), dataR(), nbPos_);
 }
 
 std::string RankVal::str() const {
 	std::string res;
 	std::stringstream sstm;
 
-	for (int i = 1, size = ordering_.size(); i < size; ++i) {
-		sstm << "," << ordering_(i);
+	for (int i = 1; i < nbPos_; ++i) {
+		sstm << "," << dataO()[i];
 	}
 
 	res += sstm.str();
@@ -103,11 +160,20 @@ std::string RankVal::str() const {
 }
 
 std::ostream& operator<<(std::ostream& os, const RankVal& rv) {
-	os << rv.ordering_(0);
-	for (int i = 1, size = rv.ordering_.size(); i < size; ++i) {
-		os << "," << rv.ordering_(i);
+	os << rv.dataO()[0];
+	for (int i = 1; i < rv.nbPos_; ++i) {
+		os << "," << rv.dataO()[i];
 	}
 	return os;
 }
 
+std::size_t RankValHash::operator()(const RankVal& rv) const {
+	RankVal::ConstView ordering = rv.o();
+	std::size_t h = rv.nbPos();
+	for (int i = 0, size = ordering.size(); i < size; ++i) {
+		h = h * 31 + ordering(i);
+	}
+	return h;
+}
+
 } // namespace mixt
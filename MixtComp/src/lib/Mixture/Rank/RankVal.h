@@ -23,8 +23,11 @@
 #ifndef RANKVAL_H
 #define RANKVAL_H
 
-#include <LinAlg/LinAlg.h>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+
+#include <LinAlg/LinAlg.h>
 
 namespace mixt {
 
@@ -32,9 +35,23 @@ namespace mixt {
  * Both ordering (position -> modality) and ranking (modality -> position) are used in the RankCluster
  * algorithm. RankVal stores and update both representations, allowing easy operations on rank values. It
  * could be used to store both completed values of observation or central rank (mu) in the parameters.
+ *
+ * The two representations share a single buffer, which is stored inside the object for ranks of up to nbPosInline
+ * positions, and allocated on the heap otherwise. Hence the copies of small ranks, for example in forEachCompleted or in
+ * the tables of observed probabilities, do not allocate memory.
  */
 class RankVal {
 public:
+	/** Read-only access to a representation, with the interface of a Vector<int>, without copy */
+	typedef Eigen::Map<const Eigen::Matrix<int, Eigen::Dynamic, 1>> ConstView;
+
+	/** Largest number of positions stored inside the object. Larger values save allocations for longer ranks, at the
+	 * cost of memory for every rank. */
+	static constexpr int nbPosInline = 8;
+
+	/** Largest number of positions for which the index of a rank fits in 64 bits, see index */
+	static constexpr int nbPosIndexMax = 20;
+
 	RankVal();
 
 	RankVal(int nbPos);
@@ -42,7 +59,13 @@ public:
 	/** Set ordering via initializer list */
 	RankVal(const std::initializer_list<int>& il);
 
-	void operator=(const RankVal& rv);
+	RankVal(const RankVal& rv);
+
+	RankVal(RankVal&& rv);
+
+	RankVal& operator=(const RankVal& rv);
+
+	RankVal& operator=(RankVal&& rv);
 
 	bool operator==(const RankVal& rv) const;
 
@@ -60,15 +83,12 @@ public:
 	 * */
 	template<typename T>
 	void setO(const T& data) {
-		typename T::const_iterator itD = data.begin();
-		typename T::const_iterator itDE = data.end();
-		Vector<int>::iterator itV = ordering_.begin();
-
-		for (; itD != itDE; ++itD, ++itV) {
-			*itV = *itD;
+		int* ordering = dataO();
+		for (typename T::const_iterator itD = data.begin(), itDE = data.end(); itD != itDE; ++itD, ++ordering) {
+			*ordering = *itD;
 		}
 
-		switchRepresentation(ordering_, ranking_);
+		switchRepresentation(dataO(), dataR(), nbPos_);
 	}
 
 	/**
@@ -77,15 +97,12 @@ public:
 	 * */
 	template<typename T>
 	void setR(const T& data) {
-		typename T::const_iterator itD = data.begin();
-		typename T::const_iterator itDE = data.end();
-		Vector<int>::iterator itV = ranking_.begin();
-
-		for (; itD != itDE; ++itD, ++itV) {
-			*itV = *itD;
+		int* ranking = dataR();
+		for (typename T::const_iterator itD = data.begin(), itDE = data.end(); itD != itDE; ++itD, ++ranking) {
+			*ranking = *itD;
 		}
 
-		switchRepresentation(ranking_, ordering_);
+		switchRepresentation(dataR(), dataO(), nbPos_);
 	}
 
 	void switchRepresentation(const Vector<int>& mu, Vector<int>& muP) const;
@@ -95,30 +112,72 @@ public:
 	 * @param firstElem index of the first element in ordering representation */
 	void permutation(int firstElem);
 
-	const Vector<int>& o() const {
-		return ordering_;
+	ConstView o() const {
+		return ConstView(dataO(), nbPos_);
 	}
 
-	const Vector<int>& r() const {
-		return ranking_;
+	ConstView r() const {
+		return ConstView(dataR(), nbPos_);
 	}
 
+	/**
+	 * Index of the ordering among the nbPos! orderings sorted in lexicographic order, computed from its Lehmer code in
+	 * O(nbPos^2). This is a compact key for the tables of ranks, which is only valid up to nbPosIndexMax positions.
+	 */
+	std::uint64_t index() const;
+
+	/** Set the ordering from its index, see index. The number of positions must have been set before. */
+	void setIndex(std::uint64_t index);
+
 	friend std::ostream& operator<<(std::ostream& os, const RankVal& rv);
 
 	std::string str() const;
 private:
+	/** Fill muP so that muP(mu(p)) = p */
+	static void switchRepresentation(const int* mu, int* muP, int nbPos);
+
+	/** Buffer of the ordering, followed by the ranking */
+	int* data() {
+		return (nbPos_ <= nbPosInline) ? inline_ : heap_.get();
+	}
+
+	const int* data() const {
+		return (nbPos_ <= nbPosInline) ? inline_ : heap_.get();
+	}
+
+	int* dataO() {
+		return data();
+	}
+
+	const int* dataO() const {
+		return data();
+	}
+
+	int* dataR() {
+		return data() + nbPos_;
+	}
+
+	const int* dataR() const {
+		return data() + nbPos_;
+	}
+
 	/** */
 	int nbPos_;
 
-	/** ordering representation */
-	Vector<int> ordering_;
+	/** Storage of both representations when nbPos_ <= nbPosInline */
+	int inline_[2 * nbPosInline];
 
-	/** ranking representation */
-	Vector<int> ranking_;
+	/** Storage of both representations when nbPos_ > nbPosInline */
+	std::unique_ptr<int[]> heap_;
 };
 
 std::ostream& operator<<(std::ostream& os, const RankVal& rv);
 
+/** Hash of the ordering, to use RankVal as a key of std::unordered_map */
+struct RankValHash {
+	std::size_t operator()(const RankVal& rv) const;
+};
+
 } // namespace mixt
 
 #endif // RANKVAL_H
@@ -0,0 +1,239 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+#ifndef LIB_MIXTURE_SIMPLE_CLASSSUFFSTAT_H
+#define LIB_MIXTURE_SIMPLE_CLASSSUFFSTAT_H
+
+#include <algorithm>
+#include <vector>
+
+#include <Data/AugmentedData.h>
+#include <LinAlg/LinAlg.h>
+#include <Various/Constants.h>
+
+namespace mixt {
+
+/**
+ * Per class sufficient statistics of a simple model, kept up to date between two mStep. Once the SEM has settled, only
+ * a few individuals change class or have a resampled missing value between two iterations, hence only their
+ * contributions are removed from their old class and added to their new class, instead of recomputing the statistics of
+ * every class from scratch.
+ *
+ * The statistics are brought in line with the partition and the current data by update, which is called by the model
+ * in mStepShared. On the partition of z, the candidates are the individuals that moved, as recorded by ZClassInd::setZ,
+ * and the partially observed individuals, which are the only ones whose value is modified by initData and
+ * samplingStepNoCheck. Hence an update costs O(nMoved + nPartial) instead of O(nInd). On any other partition, every
+ * individual is compared to the class and value it is accounted with.
+ *
+ * A full recomputation is performed every nSuffStatUpdate updates to bound the floating point drift, whenever a Stat is
+ * no longer consistent after the incremental updates, and whenever more than a quarter of the individuals changed,
+ * since it is then not more expensive.
+ *
+ * Stat must be copyable and provide:
+ * - void clear(), reset to the statistics of an empty class
+ * - void add(Value x) and void remove(Value x), with Value the type of the elements of Data
+ * - bool consistent() const, false if the rounding errors of the removals made the statistics invalid, for example a
+ * negative sum of squares
+ */
+template<typename Data, typename Stat>
+class ClassSuffStat {
+public:
+	typedef typename Data::Scalar Value;
+
+	ClassSuffStat() :
+			nClass_(0), p_data_(nullptr), nUpdate_(0), zSync_(false) {
+	}
+
+	/**
+	 * @param nClass number of classes
+	 * @param augData data of the model, which is read at each update and must outlive this object
+	 * @param emptyStat statistics of an empty class, copied in every class
+	 */
+	void setData(Index nClass, const AugmentedData<Data>& augData, const Stat& emptyStat) {
+		nClass_ = nClass;
+		p_data_ = &augData.data_;
+		stat_.assign(nClass, emptyStat);
+
+		Index nInd = augData.data_.size();
+		statClass_.resize(nInd);
+		statClass_ = nClass; // no individual is accounted for yet
+		statValue_.resize(nInd);
+		currClass_.resize(nInd);
+
+		partialInd_.clear();
+		for (Index i = 0; i < nInd; ++i) {
+			if (augData.misData_(i).first != present_) {
+				partialInd_.push_back(i);
+			}
+		}
+
+		nUpdate_ = nSuffStatUpdate; // the first update is a full computation
+		zSync_ = false;
+	}
+
+	/**
+	 * Update the statistics so that they correspond to classInd and to the current data.
+	 *
+	 * @param movedInd see IMixture::mStepShared, nullptr if classInd is not the partition of z
+	 */
+	void update(const Vector<std::vector<Index>>& classInd, const std::vector<Index>* movedInd) {
+		bool wasSync = zSync_;
+		zSync_ = (movedInd != nullptr); // the statistics will correspond to the partition of z
+
+		if (nSuffStatUpdate <= nUpdate_) {
+			recompute(classInd);
+			return;
+		}
+
+		changed_.clear();
+		if (movedInd != nullptr && wasSync) {
+			findChanged(classInd, *movedInd);
+		} else {
+			findChangedAll(classInd);
+		}
+
+		const Data& data = *p_data_;
+		Index nInd = data.size();
+		if (nInd < 4 * changed_.size()) {
+			recompute(classInd);
+			return;
+		}
+
+		for (std::vector<std::pair<Index, Index>>::const_iterator it = changed_.begin(), itE = changed_.end(); it != itE; ++it) {
+			Index i = it->first;
+
+			if (statClass_(i) != nClass_) {
+				stat_[statClass_(i)].remove(statValue_(i));
+			}
+
+			statClass_(i) = it->second;
+			statValue_(i) = data(i);
+
+			if (statClass_(i) != nClass_) {
+				stat_[statClass_(i)].add(statValue_(i));
+			}
+		}
+
+		for (Index k = 0; k < nClass_; ++k) {
+			if (!stat_[k].consistent()) {
+				recompute(classInd);
+				return;
+			}
+		}
+
+		++nUpdate_;
+	}
+
+	/** Statistics of class k, as of the last update. */
+	const Stat& stat(Index k) const {
+		return stat_[k];
+	}
+
+private:
+	/** Computation of the statistics from scratch, adding the individuals of each class in the order of classInd. */
+	void recompute(const Vector<std::vector<Index>>& classInd) {
+		const Data& data = *p_data_;
+
+		statClass_ = nClass_;
+		for (Index k = 0; k < nClass_; ++k) {
+			stat_[k].clear();
+			for (std::vector<Index>::const_iterator it = classInd(k).begin(), itE = classInd(k).end(); it != itE; ++it) {
+				statClass_(*it) = k;
+				statValue_(*it) = data(*it);
+				stat_[k].add(data(*it));
+			}
+		}
+
+		nUpdate_ = 0;
+	}
+
+	/** True if individual i, now in class k, is accounted with another class or another value. */
+	bool isChanged(Index i, Index k) const {
+		return k != statClass_(i) || (k != nClass_ && (*p_data_)(i) != statValue_(i));
+	}
+
+	/** Fill changed_ by comparing every individual to the class and value it is accounted with. */
+	void findChangedAll(const Vector<std::vector<Index>>& classInd) {
+		Index nInd = p_data_->size();
+
+		currClass_ = nClass_;
+		for (Index k = 0; k < nClass_; ++k) {
+			for (std::vector<Index>::const_iterator it = classInd(k).begin(), itE = classInd(k).end(); it != itE; ++it) {
+				currClass_(*it) = k;
+			}
+		}
+
+		for (Index i = 0; i < nInd; ++i) {
+			if (isChanged(i, currClass_(i))) {
+				changed_.push_back(std::make_pair(i, currClass_(i)));
+			}
+		}
+	}
+
+	/**
+	 * Fill changed_ by only examining the moved and partially observed individuals, in increasing order so that the
+	 * arithmetic is the same as in findChangedAll. The class of a candidate is found by a binary search in the sorted
+	 * classInd.
+	 */
+	void findChanged(const Vector<std::vector<Index>>& classInd, const std::vector<Index>& movedInd) {
+		candidate_.assign(movedInd.begin(), movedInd.end());
+		candidate_.insert(candidate_.end(), partialInd_.begin(), partialInd_.end());
+		std::sort(candidate_.begin(), candidate_.end());
+		candidate_.erase(std::unique(candidate_.begin(), candidate_.end()), candidate_.end());
+
+		for (std::vector<Index>::const_iterator it = candidate_.begin(), itE = candidate_.end(); it != itE; ++it) {
+			Index k = 0;
+			while (k < nClass_ && !std::binary_search(classInd(k).begin(), classInd(k).end(), *it)) {
+				++k;
+			}
+
+			if (isChanged(*it, k)) {
+				changed_.push_back(std::make_pair(*it, k));
+			}
+		}
+	}
+
+	Index nClass_;
+
+	const Data* p_data_;
+
+	/** Statistics of each class */
+	std::vector<Stat> stat_;
+
+	/** Class in which each individual is accounted in stat_, nClass_ if it is in none */
+	Vector<Index> statClass_;
+
+	/** Value with which each individual is accounted in stat_ */
+	Vector<Value> statValue_;
+
+	/** Sorted indices of the individuals whose value is not fully observed, the only ones whose value can change */
+	std::vector<Index> partialInd_;
+
+	/** Buffers used in update, kept to avoid allocations. changed_ contains (individual, current class) pairs. */
+	Vector<Index> currClass_;
+	std::vector<Index> candidate_;
+	std::vector<std::pair<Index, Index>> changed_;
+
+	/** Number of incremental updates since the last full computation */
+	Index nUpdate_;
+
+	/** True if the last update was performed on the partition of z, so that the next one can rely on movedInd */
+	bool zSync_;
+};
+
+} // namespace mixt
+
+#endif /* LIB_MIXTURE_SIMPLE_CLASSSUFFSTAT_H */
@@ -20,6 +20,7 @@
  *  Authors:    Vincent KUBICKI <vincent.kubicki@inria.fr>
  **/
 
+#include <algorithm>
 #include <cmath>
 
 #include <Data/AugmentedData.h>
@@ -58,32 +59,38 @@ bool Gaussian::hasModalities() const {
 	return false;
 }
 
-std::string Gaussian::mStep(const Vector<std::set<Index>>& classInd) {
+std::string Gaussian::mStepShared(const Vector<std::vector<Index>>& classInd, const std::vector<Index>* movedInd) {
+	suffStat_.update(classInd, movedInd);
+	return "";
+}
+
+std::string Gaussian::mStep(const Vector<std::vector<Index>>& classInd, Index k) {
 	std::string warnLog;
 
-	for (Index k = 0; k < nClass_; ++k) {
-		Real mean;
-		Real sd;
-
-		meanSD(classInd(k), *p_data_, mean, sd);
-
-		param_(2 * k) = mean;
-		param_(2 * k + 1) = sd;
-
-		if (sd < epsilon) {
-			warnLog +=
-					"Gaussian variables must have a minimum standard deviation of "
-							+ epsilonStr
-							+ " in each class. It is not the case in class: "
-							+ std::to_string(k)
-							+ ". If some values are repeated often in this variable, maybe a Multinomial or a Poisson variable will describe it better."
-							+ eol;
-		}
+	const SuffStat& stat = suffStat_.stat(k);
+	Real mean = stat.mean_;
+	Real sd = std::sqrt(stat.M2_ / Real(stat.n_)); // ClassSuffStat recomputes the statistics if M2_ has become negative
+
+	param_(2 * k) = mean;
+	param_(2 * k + 1) = sd;
+
+	if (sd < epsilon) {
+		warnLog +=
+				"Gaussian variables must have a minimum standard deviation of "
+						+ epsilonStr
+						+ " in each class. It is not the case in class: "
+						+ std::to_string(k)
+						+ ". If some values are repeated often in this variable, maybe a Multinomial or a Poisson variable will describe it better."
+						+ eol;
 	}
 
 	return warnLog;
 }
 
+Real Gaussian::mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const {
+	return classInd(k).size();
+}
+
 std::vector<std::string> Gaussian::paramNames() const {
 	std::vector<std::string> names(nClass_ * 2);
 	for (int k = 0; k < nClass_; ++k) {
@@ -101,6 +108,7 @@ std::string Gaussian::setData(const std::string& paramStr,
 	std::string warnLog;
 
 	p_data_ = &(augData.data_);
+	suffStat_.setData(nClass_, augData, SuffStat());
 
 	return warnLog;
 }
@@ -119,7 +127,7 @@ void Gaussian::writeParameters() const {
 }
 
 std::string Gaussian::checkSampleCondition(
-		const Vector<std::set<Index>>& classInd) const {
+		const Vector<std::vector<Index>>& classInd) const {
 	for (Index k = 0; k < nClass_; ++k) {
 		if (classInd(k).size() < 2) {
 			return "Gaussian variables must have at least two individuals per class. This is not the case for at least one class. You can check whether you have enough individuals regarding the number of classes."
@@ -24,10 +24,10 @@
 #define GAUSSIAN_H
 
 #include <vector>
-#include <set>
 
 #include <LinAlg/LinAlg.h>
 #include <Data/ConfIntDataStat.h>
+#include <Mixture/Simple/ClassSuffStat.h>
 #include "GaussianLikelihood.h"
 #include "GaussianSampler.h"
 
@@ -57,13 +57,20 @@ public:
 	 * Algorithm based on http://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Incremental_algorithm
 	 * using the biased estimator which corresponds to the maximum likelihood estimator
 	 */
-	std::string mStep(const Vector<std::set<Index>>& classInd);
+	/** Update the sufficient statistics of all classes, see IMixture::mStepShared. */
+	std::string mStepShared(const Vector<std::vector<Index>>& classInd, const std::vector<Index>* movedInd);
+
+	/** Estimate the parameters of class k, the other classes are left untouched. */
+	std::string mStep(const Vector<std::vector<Index>>& classInd, Index k);
+
+	/** Relative cost of mStep(classInd, k), see IMixture::mStepCost. */
+	Real mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const;
 
 	std::vector<std::string> paramNames() const;
 
 	void writeParameters() const;
 
-	std::string checkSampleCondition(const Vector<std::set<Index>>& classInd) const;
+	std::string checkSampleCondition(const Vector<std::vector<Index>>& classInd) const;
 
 	void initParam();
 
@@ -75,6 +82,48 @@ private:
 	Vector<Real>& param_;
 
 	Vector<Real>* p_data_;
+
+	/** Number of individuals, mean and sum of squared deviations of a class, using the incremental algorithm of meanSD */
+	struct SuffStat {
+		SuffStat() {
+			clear();
+		}
+
+		void clear() {
+			n_ = 0;
+			mean_ = 0.;
+			M2_ = 0.;
+		}
+
+		void add(Real x) {
+			++n_;
+			Real delta = x - mean_;
+			mean_ = mean_ + delta / Real(n_);
+			M2_ = M2_ + delta * (x - mean_);
+		}
+
+		void remove(Real x) {
+			--n_;
+			if (n_ == 0) {
+				clear();
+				return;
+			}
+			Real delta = x - mean_;
+			mean_ = mean_ - delta / Real(n_);
+			M2_ = M2_ - delta * (x - mean_);
+		}
+
+		/** The removals can make M2_ negative when the remaining individuals are close to each other. */
+		bool consistent() const {
+			return 0. <= M2_;
+		}
+
+		Index n_;
+		Real mean_;
+		Real M2_;
+	};
+
+	ClassSuffStat<Vector<Real>, SuffStat> suffStat_;
 };
 
 }
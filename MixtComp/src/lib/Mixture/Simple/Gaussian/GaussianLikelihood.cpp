@@ -23,6 +23,7 @@
 #include "GaussianLikelihood.h"
 #include <Various/Enum.h>
 #include <LinAlg/LinAlg.h>
+#include <Various/Constants.h>
 
 namespace mixt {
 
@@ -43,6 +44,18 @@ Real GaussianLikelihood::lnCompletedProbability(int i, int k) const {
   return logProba;
 }
 
+void GaussianLikelihood::lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+  Index nInd = iEnd - iBegin;
+
+  for (Index k = 0; k < Index(lnProba.cols()); ++k) {
+    Real mean  = param_(2 * k    );
+    Real sd    = param_(2 * k + 1);
+    Real cst   = -std::log(sd) - logsqrt2pi; // same order of operations as GaussianStatistic::lpdf, hence the same result
+
+    lnProba.col(k).array() += cst - 0.5 * ((augData_.data_.segment(iBegin, nInd).array() - mean) / sd).square(); // dense expression, vectorized by Eigen
+  }
+}
+
 Real GaussianLikelihood::lnObservedProbability(int i, int k) const {
   Real mean  = param_(2 * k    );
   Real sd    = param_(2 * k + 1);
@@ -63,8 +76,9 @@ Real GaussianLikelihood::lnObservedProbability(int i, int k) const {
     break;
 
     case missingIntervals_: {
-      Real infBound  = augData_.misData_(i).second[0];
-      Real supBound  = augData_.misData_(i).second[1];
+      MisDataTable<Real>::Param bounds = augData_.misData_(i).second;
+      Real infBound  = bounds[0];
+      Real supBound  = bounds[1];
       Real infCdf = normal_.cdf(infBound,
                                 mean,
                                 sd);
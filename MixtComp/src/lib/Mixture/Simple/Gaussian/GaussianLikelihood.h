@@ -41,6 +41,9 @@ class GaussianLikelihood
     /** Compute the completed log-likelihood */
     Real lnCompletedProbability(int i, int k) const;
 
+    /** Add the completed log-likelihood of individuals iBegin to iEnd - 1 to lnProba, one column per class, see IMixture::lnCompletedProbabilityBlock */
+    void lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const;
+
     /** Compute the observed log-likelihood */
     Real lnObservedProbability(int i, int k) const;
 
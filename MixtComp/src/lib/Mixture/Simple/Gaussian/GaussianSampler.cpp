@@ -47,8 +47,9 @@ void GaussianSampler::samplingStepNoCheck(int i,
       break;
 
       case missingIntervals_: {
-        Real infBound = augData_.misData_(i).second[0];
-        Real supBound = augData_.misData_(i).second[1];
+        MisDataTable<Real>::Param bounds = augData_.misData_(i).second;
+        Real infBound = bounds[0];
+        Real supBound = bounds[1];
 
         z = normal_.sampleI(mean,
                             sd,
@@ -54,25 +54,26 @@ int Multinomial::computeNbFreeParameters() const {
 	return nClass_ * (nModality_ - 1);
 }
 
-std::string Multinomial::mStep(const Vector<std::set<Index>>& classInd) {
-	for (Index k = 0; k < nClass_; ++k) {
-		Vector<Real> modalities(nModality_, 0.);
-
-		for (std::set<Index>::const_iterator it = classInd(k).begin(), itE =
-				classInd(k).end(); it != itE; ++it) {
-			modalities((*p_data_)(*it)) += 1.;
-		}
+std::string Multinomial::mStepShared(const Vector<std::vector<Index>>& classInd, const std::vector<Index>* movedInd) {
+	suffStat_.update(classInd, movedInd);
+	return "";
+}
 
-		modalities = modalities / Real(classInd(k).size());
+std::string Multinomial::mStep(const Vector<std::vector<Index>>& classInd, Index k) {
+	const SuffStat& stat = suffStat_.stat(k);
+	Vector<Real> modalities = stat.count_ / Real(stat.n_);
 
-		for (Index p = 0; p < nModality_; ++p) {
-			param_(k * nModality_ + p) = modalities(p);
-		}
+	for (Index p = 0; p < nModality_; ++p) {
+		param_(k * nModality_ + p) = modalities(p);
 	}
 
 	return "";
 }
 
+Real Multinomial::mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const {
+	return classInd(k).size();
+}
+
 std::vector<std::string> Multinomial::paramNames() const {
 	std::vector<std::string> names(nClass_ * nModality_);
 	for (Index k = 0; k < nClass_; ++k) {
@@ -158,6 +159,10 @@ std::string Multinomial::setData(std::string& paramStr,
 	augData.dataRange_.max_ = nModality_ - 1;
 	augData.dataRange_.range_ = nModality_;
 
+	if (warnLog.size() == 0) { // nModality_ is known and the data is within the parameter space
+		suffStat_.setData(nClass_, augData, SuffStat(nModality_));
+	}
+
 	return warnLog;
 }
 
@@ -177,14 +182,14 @@ void Multinomial::writeParameters() const {
 }
 
 std::string Multinomial::checkSampleCondition(
-		const Vector<std::set<Index>>& classInd) const {
+		const Vector<std::vector<Index>>& classInd) const {
 	if (degeneracyAuthorizedForNonBoundedLikelihood)
 		return "";
 
 	for (Index k = 0; k < nClass_; ++k) {
 		std::string warnLog;
 		Vector<bool> modalityPresent(nModality_, false);
-		for (std::set<Index>::const_iterator it = classInd(k).begin(), itE =
+		for (std::vector<Index>::const_iterator it = classInd(k).begin(), itE =
 				classInd(k).end(); it != itE; ++it) {
 			modalityPresent((*p_data_)(*it)) = true;
 			if (modalityPresent == true) { // each modality is present i
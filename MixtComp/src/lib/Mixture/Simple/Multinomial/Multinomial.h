@@ -25,11 +25,11 @@
 #define MULTINOMIAL_H
 
 #include <LinAlg/LinAlg.h>
+#include <Mixture/Simple/ClassSuffStat.h>
 #include <Mixture/Simple/Multinomial/MultinomialDataStat.h>
 #include <Mixture/Simple/Multinomial/MultinomialLikelihood.h>
 #include <Mixture/Simple/Multinomial/MultinomialSampler.h>
 #include <vector>
-#include <set>
 
 
 namespace mixt {
@@ -50,7 +50,14 @@ public:
 
 	int computeNbFreeParameters() const;
 
-	std::string mStep(const Vector<std::set<Index>>& classInd);
+	/** Update the sufficient statistics of all classes, see IMixture::mStepShared. */
+	std::string mStepShared(const Vector<std::vector<Index>>& classInd, const std::vector<Index>* movedInd);
+
+	/** Estimate the parameters of class k, the other classes are left untouched. */
+	std::string mStep(const Vector<std::vector<Index>>& classInd, Index k);
+
+	/** Relative cost of mStep(classInd, k), see IMixture::mStepCost. */
+	Real mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const;
 
 	std::vector<std::string> paramNames() const;
 
@@ -60,7 +67,7 @@ public:
 	void writeParameters() const;
 
 	std::string checkSampleCondition(
-			const Vector<std::set<Index>>& classInd) const;
+			const Vector<std::vector<Index>>& classInd) const;
 
 	bool hasModalities() const;
 
@@ -75,6 +82,39 @@ private:
 
 	Vector<int>* p_data_;
 
+	/** Number of individuals of a class and number of occurrences of each modality in it */
+	struct SuffStat {
+		SuffStat(Index nModality = 0) :
+				count_(nModality) {
+			clear();
+		}
+
+		void clear() {
+			n_ = 0;
+			count_ = 0.;
+		}
+
+		void add(int x) {
+			++n_;
+			count_(x) += 1.;
+		}
+
+		void remove(int x) {
+			--n_;
+			count_(x) -= 1.;
+		}
+
+		/** The counts are exact. */
+		bool consistent() const {
+			return true;
+		}
+
+		Index n_;
+		Vector<Real> count_;
+	};
+
+	ClassSuffStat<Vector<int>, SuffStat> suffStat_;
+
 	Vector<Real>& param_;
 };
 
@@ -25,42 +25,55 @@
 
 namespace mixt {
 
-MultinomialDataStat::MultinomialDataStat(AugmentedData<Vector<int> >& augData, Real confidenceLevel) :
-		augData_(augData), confidenceLevel_(confidenceLevel) {
+MultinomialDataStat::MultinomialDataStat(AugmentedData<Vector<int> >& augData, Real confidenceLevel, DataStatMode) :
+		augData_(augData), confidenceLevel_(confidenceLevel), nSlot_(0) {
 }
 
 void MultinomialDataStat::setNbIndividual(int nbInd) {
-	stat_.resize(nbInd);
 	dataStatStorage_.resize(nbInd);
+	slot_.resize(nbInd);
+
+	nSlot_ = 0;
+	for (int ind = 0; ind < nbInd; ++ind) {
+		slot_(ind) = (augData_.misData_(ind).first != present_) ? nSlot_++ : nbInd;
+	}
+}
+
+void MultinomialDataStat::beginGibbsRun(Index) {
+	stat_.resize(augData_.dataRange_.max_ + 1, nSlot_);
+	stat_ = 0.;
+}
+
+void MultinomialDataStat::endGibbsRun() {
+	stat_.resize(0, 0);
 }
 
 void MultinomialDataStat::sample(int ind) {
 	int currMod = augData_.data_(ind);
-	stat_(ind)(currMod) += 1.;
+	stat_(currMod, slot_(ind)) += 1.;
 }
 
 void MultinomialDataStat::sampleVals(int ind, int iteration, int iterationMax) {
 	if (augData_.misData_(ind).first != present_) {
-		if (iteration == 0) { // clear the temporary statistical object
-			stat_(ind).resize(augData_.dataRange_.max_ + 1); // initialize internal storage
-			stat_(ind) = 0.;
+		Index slot = slot_(ind);
 
+		if (iteration == 0) {
 			dataStatStorage_(ind) = std::vector<std::pair<int, Real> >(); // clear output storage for current individual, a vector of <modality, proba>, ordered by decreasing probability up to a cut-off defined by confidenceLevel
 
 			sample(ind); // first sampling, on each missing variables
 		} else if (iteration == iterationMax) { // export the statistics to the p_dataStatStorage object
 			sample(ind); // last sampling
 
-			stat_(ind) /= Real(iterationMax + 1); // from count to probabilities
+			Vector<Real> proba = stat_.col(slot) / Real(iterationMax + 1); // from count to probabilities
 			Vector<int> indOrder; // to store indices of ascending order
-			stat_(ind).sortIndex(indOrder);
+			proba.sortIndex(indOrder);
 			Real cumProb = 0.;
 
 			for (int i = augData_.dataRange_.max_; // from the most probable modality ...
 			i > -1; // ... to the least probable modality
 					--i) {
 				int currMod = indOrder(i);
-				Real currProba = stat_(ind)(currMod);
+				Real currProba = proba(currMod);
 				dataStatStorage_(ind).push_back(std::pair<int, Real>(currMod, currProba));
 				cumProb += currProba;
 
@@ -68,8 +81,6 @@ void MultinomialDataStat::sampleVals(int ind, int iteration, int iterationMax) {
 					break;
 				}
 			}
-
-			stat_(ind).resize(0); // clear memory for current individual
 		} else { // any other iteration: just store the current value
 			sample(ind);
 		}
@@ -25,15 +25,29 @@
 
 #include <LinAlg/LinAlg.h>
 #include <Data/AugmentedData.h>
+#include <Various/Enum.h>
 
 namespace mixt {
 
+/**
+ * Distribution of the modalities sampled for the missing data during the Gibbs run phase. The memory does not depend on
+ * the number of iterations, since only the counts of each modality are kept. The counts of all the partially observed
+ * individuals are stored in a single arena, one column per individual. The arena is allocated by beginGibbsRun, before
+ * the first call to sampleVals, and freed by endGibbsRun, once the statistics of every individual have been exported.
+ */
 class MultinomialDataStat {
 public:
-	MultinomialDataStat(AugmentedData<Vector<int> >& augData, Real confidenceLevel);
+	/** The DataStatMode is ignored, the counts are always exact */
+	MultinomialDataStat(AugmentedData<Vector<int> >& augData, Real confidenceLevel, DataStatMode = exactDataStat_);
 
 	void setNbIndividual(int nbInd);
 
+	/** Allocate and clear the arena, the counts do not depend on the number of iterations */
+	void beginGibbsRun(Index iterationMax);
+
+	/** Free the arena */
+	void endGibbsRun();
+
 	void sampleVals(int sample, int iteration, int iterationMax);
 	void imputeData(int ind);
 
@@ -49,11 +63,17 @@ private:
 	/** Sparse description of the missing values */
 	Vector<std::vector<std::pair<int, Real> > > dataStatStorage_;
 
-	/** Vector of vectors to count sampled values across iterations, for the current individual,
-	 * stat_(i)(n)
-	 * i: individual
-	 * n: sampled value */
-	Vector<Vector<Real> > stat_;
+	/** Arena to count sampled values across iterations,
+	 * stat_(n, s)
+	 * n: sampled value
+	 * s: slot of the partially observed individual */
+	Matrix<Real> stat_;
+
+	/** Slot of each individual in the arena, the number of individuals for the fully observed ones */
+	Vector<Index> slot_;
+
+	/** Number of partially observed individuals */
+	Index nSlot_;
 
 	/** Confidence level */
 	Real confidenceLevel_;
@@ -49,6 +49,22 @@ class MultinomialLikelihood {
       return std::log(proba);
     }
 
+    /** Add the completed log probability of individuals iBegin to iEnd - 1 to lnProba, one column per class, see IMixture::lnCompletedProbabilityBlock */
+    void lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+      Index nbModalities = param_.rows() / nbClass_;
+      Vector<Real> lnParam(nbModalities);
+
+      for (Index k = 0; k < nbClass_; ++k) {
+        for (Index p = 0; p < nbModalities; ++p) {
+          lnParam(p) = std::log(param_(k * nbModalities + p)); // one logarithm per modality instead of one per individual
+        }
+
+        for (Index i = iBegin; i < iEnd; ++i) {
+          lnProba(i - iBegin, k) += lnParam(augData_.data_(i));
+        }
+      }
+    }
+
     /** Compute the observed log probability of individual i */
     Real lnObservedProbability(Index i, Index k) const {
       Index nbModalities = param_.rows() / nbClass_;
@@ -68,8 +84,8 @@ class MultinomialLikelihood {
         case missingFiniteValues_: { // adding the contributions of the various modalities
           proba = 0.;
 
-          for (typename std::vector<Type>::const_iterator itMiss = augData_.misData_(i).second.begin();
-               itMiss != augData_.misData_(i).second.end();
+          for (const Type* itMiss = augData_.misData_(i).second.begin(), *itEnd = augData_.misData_(i).second.end();
+               itMiss != itEnd;
                ++itMiss) {
             proba += param_(k * nbModalities + *itMiss);
           }
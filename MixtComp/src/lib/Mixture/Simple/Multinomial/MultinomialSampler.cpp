@@ -67,8 +67,8 @@ void MultinomialSampler::samplingStepNoCheck(int i,
         Vector<Real> modalities(nbModalities);
         modalities = 0.;
 
-        for(std::vector<int>::const_iterator currMod = augData_.misData_(i).second.begin();
-            currMod != augData_.misData_(i).second.end();
+        for(const int* currMod = augData_.misData_(i).second.begin(), *endMod = augData_.misData_(i).second.end();
+            currMod != endMod;
             ++currMod)
         {
 #ifdef MC_DEBUG
@@ -61,36 +61,37 @@ bool NegativeBinomial::hasModalities() const {
 	return false;
 }
 
-std::string NegativeBinomial::mStep(const Vector<std::set<Index>>& classInd) {
-
+std::string NegativeBinomial::mStep(const Vector<std::vector<Index>>& classInd, Index k) {
 	std::string warnLog;
-	for (Index k = 0; k < nClass_; ++k) {
-		Vector<int> x(classInd(k).size()); // the optimizer needs a particular format for the data
-		Index currObsInClass = 0;
-		for (std::set<Index>::const_iterator it = classInd(k).begin(), itEnd = classInd(k).end(); it != itEnd; ++it) {
-			x(currObsInClass) = (*p_data_)(*it);
-			++currObsInClass;
-		}
 
-		try {
-			Real nParam = estimateN(x, param_(2 * k)); // starting point is the current value of the parameter
-			Real pParam = estimateP(x, nParam);
+	Vector<int> x(classInd(k).size()); // the optimizer needs a particular format for the data
+	Index currObsInClass = 0;
+	for (std::vector<Index>::const_iterator it = classInd(k).begin(), itEnd = classInd(k).end(); it != itEnd; ++it) {
+		x(currObsInClass) = (*p_data_)(*it);
+		++currObsInClass;
+	}
 
-			param_(2 * k) = nParam;
-			param_(2 * k + 1) = pParam;
+	try {
+		Real nParam = estimateN(x, param_(2 * k)); // starting point is the current value of the parameter
+		Real pParam = estimateP(x, nParam);
 
-			if ((1 - pParam < epsilon) | (pParam < epsilon)) {
-				warnLog += "NegativeBinomial variables must have a p value different from 0 or 1 in each class. It is not the case in class: " + std::to_string(k) + ". " + eol;
-			}
-		} catch (boost::exception &e) {
-			warnLog += "NegativeBinomial model, parameter n divergence in class: " + std::to_string(k) + ". " + boost::diagnostic_information(e) + "." + eol;
-		}
+		param_(2 * k) = nParam;
+		param_(2 * k + 1) = pParam;
 
+		if ((1 - pParam < epsilon) | (pParam < epsilon)) {
+			warnLog += "NegativeBinomial variables must have a p value different from 0 or 1 in each class. It is not the case in class: " + std::to_string(k) + ". " + eol;
+		}
+	} catch (boost::exception &e) {
+		warnLog += "NegativeBinomial model, parameter n divergence in class: " + std::to_string(k) + ". " + boost::diagnostic_information(e) + "." + eol;
 	}
 
 	return warnLog;
 }
 
+Real NegativeBinomial::mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const {
+	return Real(classInd(k).size()) * maxIterationOptim; // each Newton-Raphson iteration evaluates digamma and trigamma on every individual
+}
+
 std::pair<Real, Real> NegativeBinomial::evalFuncDeriv(const Vector<int>& x, Real n) const {
 	Index nObs = x.size();
 
@@ -172,7 +173,7 @@ void NegativeBinomial::writeParameters() const {
 #endif
 }
 
-std::string NegativeBinomial::checkSampleCondition(const Vector<std::set<Index>>& classInd) const {
+std::string NegativeBinomial::checkSampleCondition(const Vector<std::vector<Index>>& classInd) const {
 
 	return "";
 }
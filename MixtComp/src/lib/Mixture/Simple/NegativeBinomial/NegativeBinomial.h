@@ -24,7 +24,6 @@
 #define NEGATIVEBINOMIAL_H
 
 #include <vector>
-#include <set>
 
 #include <Data/AugmentedData.h>
 #include <Data/ConfIntDataStat.h>
@@ -53,7 +52,16 @@ public:
 	std::string setData(const std::string& paramStr,
 			AugmentedData<Vector<int> >& augData, RunMode mode);
 
-	std::string mStep(const Vector<std::set<Index>>& classInd);
+	/** Nothing is shared between classes, see IMixture::mStepShared. */
+	std::string mStepShared(const Vector<std::vector<Index>>&, const std::vector<Index>*) {
+		return "";
+	}
+
+	/** Estimate the parameters of class k, the other classes are left untouched. */
+	std::string mStep(const Vector<std::vector<Index>>& classInd, Index k);
+
+	/** Relative cost of mStep(classInd, k), see IMixture::mStepCost. */
+	Real mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const;
 
 	Real estimateN(const Vector<int>& x, Real n0) const;
 
@@ -66,7 +74,7 @@ public:
 	void writeParameters() const;
 
 	std::string checkSampleCondition(
-			const Vector<std::set<Index>>& classInd) const;
+			const Vector<std::vector<Index>>& classInd) const;
 
 	void initParam();
 
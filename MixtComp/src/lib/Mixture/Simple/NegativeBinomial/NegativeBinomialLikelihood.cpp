@@ -38,6 +38,14 @@ Real NegativeBinomialLikelihood::lnCompletedProbability(int i, int k) const {
   return negativeBinomial_.lpdf(augData_.data_(i), param_(2 * k), param_(2 * k + 1));
 }
 
+void NegativeBinomialLikelihood::lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+  for (Index k = 0; k < Index(lnProba.cols()); ++k) {
+    for (Index i = iBegin; i < iEnd; ++i) {
+      lnProba(i - iBegin, k) += lnCompletedProbability(i, k);
+    }
+  }
+}
+
 Real NegativeBinomialLikelihood::lnObservedProbability(int i, int k) const {
   Real logProba = 0.;
 
@@ -60,8 +68,9 @@ Real NegativeBinomialLikelihood::lnObservedProbability(int i, int k) const {
     break;
 
     case missingIntervals_: {
-        int infBound  = augData_.misData_(i).second[0];
-        int supBound  = augData_.misData_(i).second[1];
+        MisDataTable<int>::Param bounds = augData_.misData_(i).second;
+        int infBound  = bounds[0];
+        int supBound  = bounds[1];
         Real infCdf = negativeBinomial_.cdf(infBound, param_(2 * k), param_(2 * k + 1));
         Real supCdf = negativeBinomial_.cdf(supBound, param_(2 * k), param_(2 * k + 1));
         logProba = std::log(supCdf - infCdf);
@@ -49,7 +49,8 @@ void NegativeBinomialSampler::samplingStepNoCheck(int i, int z_i) {
 	  break;
 
 	  case missingIntervals_: {
-	    x = negativeBinomial_.sampleI(n, p, augData_.misData_(i).second[0], augData_.misData_(i).second[1]);
+	    MisDataTable<int>::Param bounds = augData_.misData_(i).second;
+	    x = negativeBinomial_.sampleI(n, p, bounds[0], bounds[1]);
 	  }
 	  break;
 
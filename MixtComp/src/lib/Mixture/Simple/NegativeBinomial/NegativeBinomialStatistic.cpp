@@ -30,8 +30,7 @@
 
 namespace mixt {
 
-NegativeBinomialStatistic::NegativeBinomialStatistic() :
-		rng_(seed(this)) {
+NegativeBinomialStatistic::NegativeBinomialStatistic() {
 }
 
 Real NegativeBinomialStatistic::pdf(int x, Real n, Real p) const {
@@ -64,7 +63,7 @@ Real NegativeBinomialStatistic::cdf(int x, Real n, Real p) const {
 
 int NegativeBinomialStatistic::sample(Real n, Real p) {
 	boost::random::negative_binomial_distribution<> nBinom(n, p);
-	boost::variate_generator<boost::mt19937&, boost::random::negative_binomial_distribution<> > generator(rng_, nBinom);
+	boost::variate_generator<Philox4x32&, boost::random::negative_binomial_distribution<> > generator(threadRNG(), nBinom);
 	int x = generator();
 
 	return x;
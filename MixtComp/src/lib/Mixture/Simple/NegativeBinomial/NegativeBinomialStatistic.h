@@ -71,9 +71,6 @@ public:
 
 
 private:
-	/** Random number generator */
-	boost::mt19937 rng_;
-
 	/** Uniform sampler used for nonZeroSample */
 	UniformStatistic uniform_;
 };
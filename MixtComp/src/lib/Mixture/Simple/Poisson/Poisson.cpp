@@ -53,22 +53,24 @@ bool Poisson::hasModalities() const {
 	return false;
 }
 
-std::string Poisson::mStep(const Vector<std::set<Index>>& classInd) {
-	std::string warnLog;
+std::string Poisson::mStepShared(const Vector<std::vector<Index>>& classInd, const std::vector<Index>* movedInd) {
+	suffStat_.update(classInd, movedInd);
+	return "";
+}
 
-	for (int k = 0; k < nClass_; ++k) {
-		Real sumClass = 0.;
-		for (std::set<Index>::const_iterator it = classInd(k).begin(), itE =
-				classInd(k).end(); it != itE; ++it) {
-			sumClass += (*p_data_)(*it);
-		}
+std::string Poisson::mStep(const Vector<std::vector<Index>>& classInd, Index k) {
+	std::string warnLog;
 
-		param_(k) = sumClass / Real(classInd(k).size());
-	}
+	const SuffStat& stat = suffStat_.stat(k);
+	param_(k) = stat.sum_ / Real(stat.n_);
 
 	return warnLog;
 }
 
+Real Poisson::mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const {
+	return classInd(k).size();
+}
+
 std::vector<std::string> Poisson::paramNames() const {
 	std::vector<std::string> names(nClass_);
 	for (int k = 0; k < nClass_; ++k) {
@@ -84,6 +86,7 @@ std::string Poisson::setData(const std::string& paramStr,
 	std::string warnLog;
 
 	p_data_ = &(augData.data_);
+	suffStat_.setData(nClass_, augData, SuffStat());
 
 	if (augData.dataRange_.min_ < 0) {
 		std::stringstream sstm;
@@ -110,12 +113,12 @@ void Poisson::writeParameters() const {
 }
 
 std::string Poisson::checkSampleCondition(
-		const Vector<std::set<Index>>& classInd) const {
+		const Vector<std::vector<Index>>& classInd) const {
 	if (degeneracyAuthorizedForNonBoundedLikelihood)
 		return "";
 
 	for (Index k = 0; k < nClass_; ++k) {
-		for (std::set<Index>::const_iterator it = classInd(k).begin(), itE =
+		for (std::vector<Index>::const_iterator it = classInd(k).begin(), itE =
 				classInd(k).end(); it != itE; ++it) {
 			if ((*p_data_)(*it) > 0) {
 				goto endItK;
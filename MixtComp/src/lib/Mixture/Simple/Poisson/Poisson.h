@@ -24,10 +24,10 @@
 #define POISSON_H
 
 #include <vector>
-#include <set>
 
 #include <Data/AugmentedData.h>
 #include <Data/ConfIntDataStat.h>
+#include <Mixture/Simple/ClassSuffStat.h>
 #include "PoissonLikelihood.h"
 #include "PoissonSampler.h"
 
@@ -53,14 +53,21 @@ public:
 	std::string setData(const std::string& paramStr,
 			AugmentedData<Vector<int> >& augData, RunMode mode);
 
-	std::string mStep(const Vector<std::set<Index>>& classInd);
+	/** Update the sufficient statistics of all classes, see IMixture::mStepShared. */
+	std::string mStepShared(const Vector<std::vector<Index>>& classInd, const std::vector<Index>* movedInd);
+
+	/** Estimate the parameters of class k, the other classes are left untouched. */
+	std::string mStep(const Vector<std::vector<Index>>& classInd, Index k);
+
+	/** Relative cost of mStep(classInd, k), see IMixture::mStepCost. */
+	Real mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const;
 
 	std::vector<std::string> paramNames() const;
 
 	void writeParameters() const;
 
 	std::string checkSampleCondition(
-			const Vector<std::set<Index>>& classInd) const;
+			const Vector<std::vector<Index>>& classInd) const;
 
 	void initParam();
 
@@ -69,6 +76,38 @@ private:
 	int nClass_;
 	Vector<Real>& param_;
 	Vector<int>* p_data_;
+
+	/** Number of individuals and sum of the values of a class, exact since the values are integers */
+	struct SuffStat {
+		SuffStat() {
+			clear();
+		}
+
+		void clear() {
+			n_ = 0;
+			sum_ = 0.;
+		}
+
+		void add(int x) {
+			++n_;
+			sum_ += x;
+		}
+
+		void remove(int x) {
+			--n_;
+			sum_ -= x;
+		}
+
+		/** The sum of integers is exact. */
+		bool consistent() const {
+			return true;
+		}
+
+		Index n_;
+		Real sum_;
+	};
+
+	ClassSuffStat<Vector<int>, SuffStat> suffStat_;
 };
 
 } // namespace mixt
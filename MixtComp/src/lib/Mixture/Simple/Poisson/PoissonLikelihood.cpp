@@ -23,6 +23,7 @@
 #include "PoissonLikelihood.h"
 #include <Various/Enum.h>
 #include <LinAlg/LinAlg.h>
+#include <LinAlg/Maths.h>
 
 namespace mixt
 {
@@ -39,6 +40,30 @@ Real PoissonLikelihood::lnCompletedProbability(int i, int k) const {
                        param_(k));;
 }
 
+void PoissonLikelihood::lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+  Index nInd = iEnd - iBegin;
+
+  Vector<Real> x(nInd);
+  Vector<Real> logFacX(nInd); // the terms that do not depend on the class are computed once per block
+  for (Index i = 0; i < nInd; ++i) {
+    x(i) = augData_.data_(iBegin + i);
+    logFacX(i) = logFac(augData_.data_(iBegin + i));
+  }
+
+  for (Index k = 0; k < Index(lnProba.cols()); ++k) {
+    Real lambda = param_(k);
+
+    if (0.0 < lambda) {
+      Real logLambda = std::log(lambda);
+      lnProba.col(k).array() += x.array() * logLambda - lambda - logFacX.array(); // same order of operations as PoissonStatistic::lpdf, hence the same result
+    } else {
+      for (Index i = iBegin; i < iEnd; ++i) {
+        lnProba(i - iBegin, k) += lnCompletedProbability(i, k);
+      }
+    }
+  }
+}
+
 Real PoissonLikelihood::lnObservedProbability(int i, int k) const {
   Real logProba = 0.;
 
@@ -62,8 +87,9 @@ Real PoissonLikelihood::lnObservedProbability(int i, int k) const {
     break;
 
     case missingIntervals_: {
-        int infBound  = augData_.misData_(i).second[0];
-        int supBound  = augData_.misData_(i).second[1];
+        MisDataTable<int>::Param bounds = augData_.misData_(i).second;
+        int infBound  = bounds[0];
+        int supBound  = bounds[1];
         Real infCdf = poisson_.cdf(infBound, param_(k));
         Real supCdf = poisson_.cdf(supBound, param_(k));
         logProba = std::log(supCdf - infCdf);
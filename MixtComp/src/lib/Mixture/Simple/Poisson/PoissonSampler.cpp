@@ -48,7 +48,8 @@ void PoissonSampler::samplingStepNoCheck(int i, int z_i) {
 	  break;
 
 	  case missingIntervals_: {
-	    x = poisson_.sampleI(lambda, augData_.misData_(i).second[0], augData_.misData_(i).second[1]);
+	    MisDataTable<int>::Param bounds = augData_.misData_(i).second;
+	    x = poisson_.sampleI(lambda, bounds[0], bounds[1]);
 	  }
 	  break;
 
@@ -31,8 +31,7 @@
 
 namespace mixt {
 
-PoissonStatistic::PoissonStatistic() :
-		rng_(seed(this)) {
+PoissonStatistic::PoissonStatistic() {
 }
 
 Real PoissonStatistic::pdf(int x, Real lambda) const {
@@ -67,8 +66,8 @@ Real PoissonStatistic::cdf(int x, Real lambda) const {
 int PoissonStatistic::sample(Real lambda) {
 	if (0.0 < lambda) {
 		boost::poisson_distribution<> pois(lambda);
-		boost::variate_generator<boost::mt19937&, boost::poisson_distribution<> > generator(
-				rng_, pois);
+		boost::variate_generator<Philox4x32&, boost::poisson_distribution<> > generator(
+				threadRNG(), pois);
 		int x = generator();
 		return x;
 	} else {
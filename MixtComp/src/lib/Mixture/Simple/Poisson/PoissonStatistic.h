@@ -69,9 +69,6 @@ public:
 	 * */
 	int nonZeroSample(Real lambda);
 private:
-	/** Random number generator */
-	boost::mt19937 rng_;
-
 	/** Uniform sampler used for nonZeroSample */
 	UniformStatistic uniform_;
 };
@@ -23,6 +23,8 @@
 #ifndef SIMPLEMIXTURE_H
 #define SIMPLEMIXTURE_H
 
+#include <algorithm>
+
 #include <Data/AugmentedData.h>
 #include <IO/IO.h>
 #include <IO/IOFunctions.h>
@@ -42,10 +44,12 @@ public:
 	/** constructor.
 	 *  @param idName id name of the mixture
 	 *  @param nbCluster number of cluster
+	 *  @param paramStatMode storage of the parameters during the SEM run phase
+	 *  @param dataStatMode storage of the sampled missing values during the Gibbs run phase
 	 **/
-	SimpleMixture(const Graph& data, const Graph& param, Graph& out, std::string const& idName, Index nbClass, Index nInd, Real confidenceLevel, const std::string& paramStr) :
+	SimpleMixture(const Graph& data, const Graph& param, Graph& out, std::string const& idName, Index nbClass, Index nInd, Real confidenceLevel, ParamStatMode paramStatMode, DataStatMode dataStatMode, const std::string& paramStr) :
 			IMixture(idName, Model::name, nbClass, nInd), dataG_(data), paramG_(param), outG_(out), param_(), model_(idName, nbClass, param_), augData_(), paramStr_(paramStr), confidenceLevel_(
-					confidenceLevel), sampler_(augData_, param_, nbClass), dataStat_(augData_, confidenceLevel), paramStat_(param_, confidenceLevel), likelihood_(param_, augData_, nbClass) {
+					confidenceLevel), sampler_(augData_, param_, nbClass), dataStat_(augData_, confidenceLevel, dataStatMode), paramStat_(param_, confidenceLevel, paramStatMode), likelihood_(param_, augData_, nbClass) {
 	}
 
 	/**
@@ -56,52 +60,40 @@ public:
 	std::string setDataParam(RunMode mode) {
 		std::string warnLog;
 
-		std::vector<std::string> dataVecStr;
-		dataG_.get_payload( { }, idName_, dataVecStr);
-		warnLog += StringToAugmentedData(idName_, dataVecStr, augData_, (model_.hasModalities()) ? (-minModality) : (0));
+		typename DataColumn<Graph>::Type dataColumn; // strings, or numbers and strings if the Graph supports numeric columns
+		dataG_.get_payload( { }, idName_, dataColumn);
+		warnLog += StringToAugmentedData(idName_, dataColumn, augData_, (model_.hasModalities()) ? (-minModality) : (0));
 
 		if (warnLog.size() > 0) {
 			return warnLog;
 		}
-		augData_.computeRange();
-		std::string tempLog = augData_.checkMissingType(model_.acceptedType()); // check if the missing data provided are compatible with the model
-
-		if (tempLog.size() > 0) { // check on the missing values description
-			std::stringstream sstm;
-			sstm << "Variable " << idName() << " has a problem with the descriptions of missing values." << std::endl << tempLog;
-			warnLog += sstm.str();
-		}
 
-		if (mode == prediction_) {
-			NamedMatrix<Real> stat;
-			paramG_.get_payload( { idName_ }, "stat", stat);
-			Index nrow = stat.mat_.rows();
-
-			paramG_.get_payload( { idName_ }, "paramStr", paramStr_);
-
-			param_.resize(nrow);
-			for (Index i = 0; i < nrow; ++i) {
-				param_(i) = stat.mat_(i, 0); // only the mode / expectation is used, quantile information is discarded
-			}
-
-			paramStat_.setParamStorage(); // paramStatStorage_ is set now, using dimensions of param_, and will not be modified during predict run by the paramStat_ object for some mixtures, there will be errors if the range of the data in prediction is different from the range of the data in learning in the case of modalities, this can not be performed earlier, as the max val is computed at model_.setModalities(nbParam)
-		}
+		return setParsedDataParam(mode);
+	}
 
-		warnLog += model_.setData(paramStr_, augData_, mode); // checks on data bounds are made here, if paramStr_.size() = 0, it might be completed here, for example using the number of modalities found in the data
+	std::string setDataParam(RunMode mode, const IMixture& source) {
+		augData_ = static_cast<const SimpleMixture&>(source).augData_;
 
-		dataStat_.setNbIndividual(nInd_);
-		return warnLog;
+		return setParsedDataParam(mode);
 	}
 
 	void sampleUnobservedAndLatent(Index ind, Index k) {
 		sampler_.samplingStepNoCheck(ind, k);
 	}
 
+	std::string mStepShared(const Vector<std::vector<Index>>& classInd, const std::vector<Index>* movedInd) {
+		return model_.mStepShared(classInd, movedInd);
+	}
+
 	/**
-	 * Estimate parameters by maximum likelihood
+	 * Estimate parameters of class k by maximum likelihood
 	 */
-	std::string mStep(const Vector<std::set<Index> >& classInd) {
-		return model_.mStep(classInd);
+	std::string mStep(const Vector<std::vector<Index>>& classInd, Index k) {
+		return model_.mStep(classInd, k);
+	}
+
+	Real mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const {
+		return model_.mStepCost(classInd, k);
 	}
 
 	/** This function should be used to store any intermediate results during
@@ -116,6 +108,14 @@ public:
 		}
 	}
 
+	void beginGibbsRun(Index iterationMax) {
+		dataStat_.beginGibbsRun(iterationMax);
+	}
+
+	void endGibbsRun() {
+		dataStat_.endGibbsRun();
+	}
+
 	void storeGibbsRun(Index sample, Index iteration, Index iterationMax) {
 		dataStat_.sampleVals(sample, iteration, iterationMax);
 		if (iteration == iterationMax) {
@@ -140,6 +140,40 @@ public:
 		return likelihood_.lnObservedProbability(i, k);
 	}
 
+	void lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+		likelihood_.lnCompletedProbabilityBlock(iBegin, iEnd, lnProba);
+	}
+
+	/**
+	 * The completed probability of a fully observed individual only depends on the parameters, which are compared with
+	 * the ones of the previous call. Only the partially observed individuals have values that are sampled.
+	 */
+	bool staleCompletedProbability(std::vector<Index>& staleInd) {
+		if (lastParam_.size() != param_.size() || lastParam_ != param_) {
+			lastParam_ = param_;
+			return true;
+		}
+
+		staleInd = partialInd_;
+		return false;
+	}
+
+	/**
+	 * For a fully observed value the observed and completed probabilities are equal, hence the vectorized completed
+	 * kernel of the likelihood is evaluated on the whole block, and only the partially observed individuals of the
+	 * block are then recomputed individually, using the interval / cdf path of lnObservedProbability.
+	 */
+	void lnObservedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+		lnProba.setZero();
+		likelihood_.lnCompletedProbabilityBlock(iBegin, iEnd, lnProba);
+
+		for (std::vector<Index>::const_iterator it = std::lower_bound(partialInd_.begin(), partialInd_.end(), iBegin), itEnd = partialInd_.end(); it != itEnd && *it < iEnd; ++it) {
+			for (Index k = 0; k < nClass_; ++k) {
+				lnProba(*it - iBegin, k) = likelihood_.lnObservedProbability(*it, k);
+			}
+		}
+	}
+
 	/** This function must return the number of free parameters.
 	 *  @return Number of free parameters
 	 */
@@ -248,7 +282,7 @@ public:
 	}
 	;
 
-	std::string checkSampleCondition(const Vector<std::set<Index> >& classInd) const {
+	std::string checkSampleCondition(const Vector<std::vector<Index>>& classInd) const {
 		std::string warnLog = model_.checkSampleCondition(classInd);
 		if (0 < warnLog.size()) {
 			return "checkSampleCondition, error in variable " + idName_ + eol + warnLog;
@@ -271,6 +305,47 @@ public:
 		return false;
 	}
 private:
+	/** End of setDataParam, once augData_ has been filled. */
+	std::string setParsedDataParam(RunMode mode) {
+		std::string warnLog;
+
+		augData_.computeRange();
+		std::string tempLog = augData_.checkMissingType(model_.acceptedType()); // check if the missing data provided are compatible with the model
+
+		if (tempLog.size() > 0) { // check on the missing values description
+			std::stringstream sstm;
+			sstm << "Variable " << idName() << " has a problem with the descriptions of missing values." << std::endl << tempLog;
+			warnLog += sstm.str();
+		}
+
+		if (mode == prediction_) {
+			NamedMatrix<Real> stat;
+			paramG_.get_payload( { idName_ }, "stat", stat);
+			Index nrow = stat.mat_.rows();
+
+			paramG_.get_payload( { idName_ }, "paramStr", paramStr_);
+
+			param_.resize(nrow);
+			for (Index i = 0; i < nrow; ++i) {
+				param_(i) = stat.mat_(i, 0); // only the mode / expectation is used, quantile information is discarded
+			}
+
+			paramStat_.setParamStorage(); // paramStatStorage_ is set now, using dimensions of param_, and will not be modified during predict run by the paramStat_ object for some mixtures, there will be errors if the range of the data in prediction is different from the range of the data in learning in the case of modalities, this can not be performed earlier, as the max val is computed at model_.setModalities(nbParam)
+		}
+
+		warnLog += model_.setData(paramStr_, augData_, mode); // checks on data bounds are made here, if paramStr_.size() = 0, it might be completed here, for example using the number of modalities found in the data
+
+		partialInd_.clear();
+		for (Index i = 0; i < nInd_; ++i) {
+			if (augData_.misData_(i).first != present_) {
+				partialInd_.push_back(i);
+			}
+		}
+
+		dataStat_.setNbIndividual(nInd_);
+		return warnLog;
+	}
+
 protected:
 	const Graph& dataG_;
 	const Graph& paramG_;
@@ -302,6 +377,12 @@ protected:
 
 	/** Computation of the observed likelihood */
 	typename Model::Likelihood likelihood_;
+
+	/** Sorted indices of the individuals whose value is not fully observed, the others use the vectorized kernel in lnObservedProbabilityBlock */
+	std::vector<Index> partialInd_;
+
+	/** Parameters at the last call of staleCompletedProbability */
+	Vector<Real> lastParam_;
 };
 
 }
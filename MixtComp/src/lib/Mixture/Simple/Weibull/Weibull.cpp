@@ -121,25 +121,27 @@ std::string Weibull::setData(const std::string& paramStr, AugmentedData<Vector<R
 	return warnLog;
 }
 
-std::string Weibull::mStep(const Vector<std::set<Index>>& classInd) {
-	for (Index k = 0; k < nClass_; ++k) {
-		Vector<Real> x(classInd(k).size()); // the optimizer needs a particular format for the data
-		Index currObsInClass = 0;
-		for (std::set<Index>::const_iterator it = classInd(k).begin(), itEnd = classInd(k).end(); it != itEnd; ++it) {
-			x(currObsInClass) = (*p_data_)(*it);
-			++currObsInClass;
-		}
+std::string Weibull::mStep(const Vector<std::vector<Index>>& classInd, Index k) {
+	Vector<Real> x(classInd(k).size()); // the optimizer needs a particular format for the data
+	Index currObsInClass = 0;
+	for (std::vector<Index>::const_iterator it = classInd(k).begin(), itEnd = classInd(k).end(); it != itEnd; ++it) {
+		x(currObsInClass) = (*p_data_)(*it);
+		++currObsInClass;
+	}
 
-		Real kParam = estimateK(x, param_(2 * k)); // starting point is the current value of the parameter
-		Real lambda = estimateLambda(x, kParam);
+	Real kParam = estimateK(x, param_(2 * k)); // starting point is the current value of the parameter
+	Real lambda = estimateLambda(x, kParam);
 
-		param_(2 * k) = kParam;
-		param_(2 * k + 1) = lambda;
-	}
+	param_(2 * k) = kParam;
+	param_(2 * k + 1) = lambda;
 
 	return "";
 }
 
+Real Weibull::mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const {
+	return Real(classInd(k).size()) * maxIterationOptim; // each Newton-Raphson iteration computes powers and logarithms of every individual
+}
+
 std::vector<std::string> Weibull::paramNames() const {
 	std::vector<std::string> names(nClass_ * 2);
 
@@ -167,11 +169,11 @@ void Weibull::writeParameters() const {
 #endif
 }
 
-std::string Weibull::checkSampleCondition(const Vector<std::set<Index>>& classInd) const {
+std::string Weibull::checkSampleCondition(const Vector<std::vector<Index>>& classInd) const {
 //  if (degeneracyAuthorizedForNonBoundedLikelihood) return ""; // Weibull pdf is unbounded, so this line should be commented out
 
 	for (Index k = 0; k < nClass_; ++k) {
-		for (std::set<Index>::const_iterator it = classInd(k).begin(), itE = classInd(k).end(); it != itE; ++it) {
+		for (std::vector<Index>::const_iterator it = classInd(k).begin(), itE = classInd(k).end(); it != itE; ++it) {
 			if (epsilon < (*p_data_)(*it)) {
 				goto endItK;
 			}
@@ -23,7 +23,7 @@
 #ifndef WEIBULL_H
 #define WEIBULL_H
 
-#include <set>
+#include <vector>
 #include <utility>
 
 #include <Data/AugmentedData.h>
@@ -72,14 +72,23 @@ public:
 	std::string setData(const std::string& paramStr,
 			AugmentedData<Vector<Real> >& augData, RunMode mode);
 
-	std::string mStep(const Vector<std::set<Index>>& classInd);
+	/** Nothing is shared between classes, see IMixture::mStepShared. */
+	std::string mStepShared(const Vector<std::vector<Index>>&, const std::vector<Index>*) {
+		return "";
+	}
+
+	/** Estimate the parameters of class k, the other classes are left untouched. */
+	std::string mStep(const Vector<std::vector<Index>>& classInd, Index k);
+
+	/** Relative cost of mStep(classInd, k), see IMixture::mStepCost. */
+	Real mStepCost(const Vector<std::vector<Index>>& classInd, Index k) const;
 
 	std::vector<std::string> paramNames() const;
 
 	void writeParameters() const;
 
 	std::string checkSampleCondition(
-			const Vector<std::set<Index>>& classInd) const;
+			const Vector<std::vector<Index>>& classInd) const;
 
 	/**
 	 * The idea is to initialize the distribution in each class with the parameters lambda = 1, and a suitable value of k
@@ -38,6 +38,21 @@ Real WeibullLikelihood::lnCompletedProbability(Index i, Index k) const {
   return logProba;
 }
 
+void WeibullLikelihood::lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const {
+  Index nInd = iEnd - iBegin;
+  auto x = augData_.data_.segment(iBegin, nInd).array();
+  Vector<Real> logX = x.log().matrix(); // the logarithm of the data does not depend on the class, it is computed once per block
+
+  for (Index k = 0; k < Index(lnProba.cols()); ++k) {
+    Real kParam = param_(2 * k    );
+    Real lambda = param_(2 * k + 1);
+    Real logLambda = std::log(lambda);
+    Real cst = std::log(kParam) - logLambda;
+
+    lnProba.col(k).array() += cst + (kParam - 1.0) * (logX.array() - logLambda) - (x / lambda).pow(kParam); // same expression as WeibullStatistic::lpdf, vectorized by Eigen
+  }
+}
+
 Real WeibullLikelihood::lnObservedProbability(Index i, Index k) const {
   Real kParam = param_(2 * k    );
   Real lambda = param_(2 * k + 1);
@@ -63,8 +78,9 @@ Real WeibullLikelihood::lnObservedProbability(Index i, Index k) const {
     break;
 
     case missingIntervals_: {
-        Real infBound  = augData_.misData_(i).second[0];
-        Real supBound  = augData_.misData_(i).second[1];
+        MisDataTable<Real>::Param bounds = augData_.misData_(i).second;
+        Real infBound  = bounds[0];
+        Real supBound  = bounds[1];
         Real infCdf = weibull_.cdf(infBound, kParam, lambda);
         Real supCdf = weibull_.cdf(supBound, kParam, lambda);
         logProba = std::log(supCdf - infCdf);
@@ -37,6 +37,9 @@ class WeibullLikelihood {
     /** Compute the completed log-likelihood */
     Real lnCompletedProbability(Index i, Index k) const;
 
+    /** Add the completed log-likelihood of individuals iBegin to iEnd - 1 to lnProba, one column per class, see IMixture::lnCompletedProbabilityBlock */
+    void lnCompletedProbabilityBlock(Index iBegin, Index iEnd, Matrix<Real>& lnProba) const;
+
     /** Compute the observed log-likelihood */
     Real lnObservedProbability(Index i, Index k) const;
 
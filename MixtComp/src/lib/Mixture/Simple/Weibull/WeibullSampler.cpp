@@ -48,7 +48,8 @@ void WeibullSampler::samplingStepNoCheck(Index i, Index z_i) {
 		  break;
 
 		  case missingIntervals_: {
-		    x = weibull_.sampleI(k, lambda, augData_.misData_(i).second[0], augData_.misData_(i).second[1]);
+		    MisDataTable<Real>::Param bounds = augData_.misData_(i).second;
+		    x = weibull_.sampleI(k, lambda, bounds[0], bounds[1]);
 		  }
 		  break;
 
@@ -28,8 +28,7 @@
 
 namespace mixt {
 
-WeibullStatistic::WeibullStatistic() :
-		rng_(seed(this)) {
+WeibullStatistic::WeibullStatistic() {
 }
 
 Real WeibullStatistic::quantile(Real k, Real lambda, Real p) const {
@@ -51,8 +50,8 @@ Real WeibullStatistic::quantileI(Real k, Real lambda, Real infBound, Real supBou
 
 Real WeibullStatistic::sample(Real k, Real lambda) {
 	boost::random::weibull_distribution<> w(k, lambda);
-	boost::variate_generator<boost::mt19937&,
-			boost::random::weibull_distribution<> > generator(rng_, w);
+	boost::variate_generator<Philox4x32&,
+			boost::random::weibull_distribution<> > generator(threadRNG(), w);
 	return generator();
 }
 
@@ -68,9 +68,6 @@ class WeibullStatistic {
 
 
   private:
-    /** Random number generator */
-    boost::random::mt19937 rng_;
-
     UniformStatistic uniform_;
 };
 
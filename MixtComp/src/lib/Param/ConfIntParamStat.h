@@ -26,24 +26,65 @@
 #include <IO/IO.h>
 #include <IO/SpecialStr.h>
 #include <LinAlg/LinAlg.h>
+#include <Param/P2Quantile.h>
+#include <Various/Constants.h>
+#include <Various/Enum.h>
+#include <algorithm>
 #include <regex>
+#include <vector>
 
 
 namespace mixt {
 
+/**
+ * Read the optional paramStat field of algo: "exact" (default) or "streaming".
+ *
+ * @param[out] mode mode read, exactParamStat_ if the field is absent or invalid
+ * @return empty string if no errors, otherwise errors description
+ */
+template<typename Graph>
+std::string paramStatMode(const Graph& algo, ParamStatMode& mode) {
+	mode = exactParamStat_;
+
+	if (!algo.exist_payload( { }, "paramStat")) {
+		return "";
+	}
+
+	std::string modeStr = algo.template get_payload<std::string>( { }, "paramStat");
+	if (modeStr == "streaming") {
+		mode = streamingParamStat_;
+	} else if (modeStr != "exact") {
+		return "paramStat in algo must be either \"exact\" or \"streaming\", not \"" + modeStr + "\"." + eol;
+	}
+
+	return "";
+}
+
+template<typename Graph>
+ParamStatMode paramStatMode(const Graph& algo) {
+	ParamStatMode mode;
+	paramStatMode(algo, mode);
+	return mode;
+}
+
 /**
  * Computation of confidence interval on parameters. Templated for int or Real cases.
  * Note that the storage uses a linearized version of the initial storage, therefore ConfIntParamStat can be templated with Vector and Matrix
  * transparently.
+ *
+ * In exactParamStat_ mode, the value of every parameter at every iteration is kept in logStorage_, and the quantiles are
+ * computed by sorting at the last iteration. In streamingParamStat_ mode, only the first nParamStatBuffer iterations are
+ * kept. Shorter runs get the exact quantiles, longer ones are estimated on the fly by P2Quantile sketches, whose memory
+ * does not depend on the number of iterations. The trace is not exported in streamingParamStat_ mode.
  * */
 template<typename ContainerType>
 class ConfIntParamStat {
 public:
 	typedef typename ContainerType::Type Type;
 
-	ConfIntParamStat(ContainerType& param, Real confidenceLevel) :
+	ConfIntParamStat(ContainerType& param, Real confidenceLevel, ParamStatMode mode = exactParamStat_) :
 			initialNIter_(0), nRows_(0), nCols_(0), nCoeff_(0), param_(param), confidenceLevel_(
-					confidenceLevel) {
+					confidenceLevel), mode_(mode) {
 	}
 
 	void sampleParam(Index iteration, Index iterationMax) {
@@ -54,14 +95,30 @@ public:
 
 			initialNIter_ = iterationMax + 1;
 
-			logStorage_.resize(nCoeff_, initialNIter_); // resize internal storage
+			if (mode_ == exactParamStat_) {
+				logStorage_.resize(nCoeff_, initialNIter_); // resize internal storage
+			} else {
+				logStorage_.resize(nCoeff_, std::min(initialNIter_, nParamStatBuffer)); // the first iterations are buffered, the sketches are only used for longer runs
+				sketch_.clear();
+			}
 			statStorage_.resize(nCoeff_, 3); // resize export storage
 
 			sample(0); // first sampling, on each parameter
 		} else if (iteration == iterationMax) {
 			sample(iterationMax); // last sampling
 
-			if (iterationMax + 1 != initialNIter_) {
+			if (mode_ == streamingParamStat_ && 0 < sketch_.size()) {
+				for (Index p = 0; p < nCoeff_; ++p) {
+					for (Index q = 0; q < 3; ++q) {
+						statStorage_(p, q) = sketch_[3 * p + q].value();
+					}
+				}
+				sketch_.clear();
+				logStorage_.resize(nCoeff_, 0);
+				return;
+			}
+
+			if (iterationMax + 1 != Index(logStorage_.cols())) {
 				logStorage_ = logStorage_.block(0, 0, nCoeff_, iterationMax + 1).eval(); // if partition is stable, iterationMax has been reduced in comparison to initialNIter_
 			}
 
@@ -77,6 +134,10 @@ public:
 				statStorage_(p, 1) = currRow(realIndLow);
 				statStorage_(p, 2) = currRow(realIndHigh + 1);
 			}
+
+			if (mode_ == streamingParamStat_) { // the run fitted in the buffer, the quantiles are exact but the trace is not exported either
+				logStorage_.resize(nCoeff_, 0);
+			}
 		} else {
 			sample(iteration); // standard sampling
 		}
@@ -148,6 +209,19 @@ public:
 
 private:
 	void sample(Index iteration) {
+		if (mode_ == streamingParamStat_ && Index(logStorage_.cols()) <= iteration) {
+			if (sketch_.size() == 0) { // buffer full, the sketches are started with the buffered iterations
+				startSketch();
+			}
+
+			for (Index j = 0; j < nCols_; ++j) {
+				for (Index i = 0; i < nRows_; ++i) {
+					addSketch(i * nCols_ + j, param_(i, j));
+				}
+			}
+			return;
+		}
+
 		for (Index j = 0; j < nCols_; ++j) {
 			for (Index i = 0; i < nRows_; ++i) {
 				logStorage_(i * nCols_ + j, iteration) = param_(i, j);
@@ -155,6 +229,28 @@ private:
 		}
 	}
 
+	void startSketch() {
+		Real alpha = (1. - confidenceLevel_) / 2.;
+		sketch_.reserve(3 * nCoeff_);
+		for (Index p = 0; p < nCoeff_; ++p) { // same layout as the columns of statStorage_
+			sketch_.emplace_back(0.5);
+			sketch_.emplace_back(alpha);
+			sketch_.emplace_back(1. - alpha);
+		}
+
+		for (Index it = 0; it < Index(logStorage_.cols()); ++it) {
+			for (Index p = 0; p < nCoeff_; ++p) {
+				addSketch(p, logStorage_(p, it));
+			}
+		}
+	}
+
+	void addSketch(Index p, Type x) {
+		for (Index q = 0; q < 3; ++q) {
+			sketch_[3 * p + q].add(x);
+		}
+	}
+
 	// number of iterations used to compute the statistics
 	Index initialNIter_;
 
@@ -173,11 +269,17 @@ private:
 
 	/** Storage for iterations results,
 	 * first dimension: index of the parameter
-	 * second dimension: iteration of the stored value */
+	 * second dimension: iteration of the stored value
+	 * In streamingParamStat_ mode, this is the buffer of the first iterations. */
 	Matrix<Type> logStorage_;
 
 	/** Confidence level */
 	Real confidenceLevel_;
+
+	ParamStatMode mode_;
+
+	/** Quantile sketches of the streaming mode, median, left quantile and right quantile for each parameter */
+	std::vector<P2Quantile> sketch_;
 };
 
 } // namespace mixt
@@ -0,0 +1,119 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "P2Quantile.h"
+
+namespace mixt {
+
+P2Quantile::P2Quantile(Real p) :
+		p_(p), count_(0) {
+	dn_[0] = 0.;
+	dn_[1] = p / 2.;
+	dn_[2] = p;
+	dn_[3] = (1. + p) / 2.;
+	dn_[4] = 1.;
+}
+
+void P2Quantile::add(Real x) {
+	if (count_ < 5) {
+		q_[count_] = x;
+		++count_;
+
+		if (count_ == 5) {
+			std::sort(q_, q_ + 5);
+			for (int i = 0; i < 5; ++i) {
+				n_[i] = i;
+			}
+			np_[0] = 0.;
+			np_[1] = 2. * p_;
+			np_[2] = 4. * p_;
+			np_[3] = 2. + 2. * p_;
+			np_[4] = 4.;
+		}
+
+		return;
+	}
+
+	++count_;
+
+	int k; // cell of x, the extreme markers are moved if x is outside of their range
+	if (x < q_[0]) {
+		q_[0] = x;
+		k = 0;
+	} else if (q_[4] <= x) {
+		q_[4] = x;
+		k = 3;
+	} else {
+		k = 0;
+		while (q_[k + 1] <= x) {
+			++k;
+		}
+	}
+
+	for (int i = k + 1; i < 5; ++i) {
+		n_[i] += 1.;
+	}
+	for (int i = 0; i < 5; ++i) {
+		np_[i] += dn_[i];
+	}
+
+	for (int i = 1; i < 4; ++i) { // adjust the heights of the inner markers if they are too far from their desired positions
+		Real d = np_[i] - n_[i];
+
+		if ((1. <= d && 1. < n_[i + 1] - n_[i]) || (d <= -1. && n_[i - 1] - n_[i] < -1.)) {
+			int sign = (0. < d) ? 1 : -1;
+
+			Real qp = parabolic(i, sign);
+			if (q_[i - 1] < qp && qp < q_[i + 1]) {
+				q_[i] = qp;
+			} else {
+				q_[i] = linear(i, sign);
+			}
+
+			n_[i] += sign;
+		}
+	}
+}
+
+Real P2Quantile::value() const {
+	if (count_ == 0) {
+		return 0.;
+	}
+
+	if (count_ < 5) { // the observations are still stored, and the quantile is exact
+		Real sorted[5];
+		std::copy(q_, q_ + count_, sorted);
+		std::sort(sorted, sorted + count_);
+		Index ind = std::min(Index(p_ * count_), count_ - 1);
+		return sorted[ind];
+	}
+
+	return q_[2];
+}
+
+Real P2Quantile::parabolic(int i, Real d) const {
+	return q_[i] + d / (n_[i + 1] - n_[i - 1]) * ((n_[i] - n_[i - 1] + d) * (q_[i + 1] - q_[i]) / (n_[i + 1] - n_[i]) + (n_[i + 1] - n_[i] - d) * (q_[i] - q_[i - 1]) / (n_[i] - n_[i - 1]));
+}
+
+Real P2Quantile::linear(int i, int d) const {
+	return q_[i] + d * (q_[i + d] - q_[i]) / (n_[i + d] - n_[i]);
+}
+
+} // namespace mixt
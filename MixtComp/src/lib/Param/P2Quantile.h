@@ -0,0 +1,69 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+
+#ifndef LIB_PARAM_P2QUANTILE_H
+#define LIB_PARAM_P2QUANTILE_H
+
+#include <LinAlg/LinAlg.h>
+
+namespace mixt {
+
+/**
+ * Streaming estimation of a quantile with the P² algorithm of Jain and Chlamtac (1985). Five markers are kept, whose
+ * heights are adjusted with a piecewise-parabolic interpolation at each new observation, hence the memory is constant
+ * whatever the number of observations. The first five observations are stored, and the quantile is exact up to there.
+ */
+class P2Quantile {
+public:
+	/** @param p probability of the estimated quantile, in [0, 1] */
+	P2Quantile(Real p);
+
+	void add(Real x);
+
+	/** Current estimation of the quantile, the observation is the only value for a single observation */
+	Real value() const;
+
+	Index count() const {
+		return count_;
+	}
+
+private:
+	/** Piecewise-parabolic prediction of the height of marker i, moved by d in {-1, 1} */
+	Real parabolic(int i, Real d) const;
+
+	Real linear(int i, int d) const;
+
+	Real p_;
+
+	Index count_;
+
+	/** Heights of the markers, which are the first observations, sorted once there are five of them */
+	Real q_[5];
+
+	/** Actual positions of the markers */
+	Real n_[5];
+
+	/** Desired positions of the markers */
+	Real np_[5];
+
+	/** Increments of the desired positions */
+	Real dn_[5];
+};
+
+} // namespace mixt
+
+#endif /* LIB_PARAM_P2QUANTILE_H */
@@ -23,7 +23,12 @@
 #ifndef LIB_RUN_LEARN_H
 #define LIB_RUN_LEARN_H
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include <Composer/MixtureComposer.h>
+#include <IO/IO.h>
 #include <Statistic/RNG.h>
 #include <Strategy/GibbsStrategy.h>
 #include <Strategy/SEMStrategy.h>
@@ -34,6 +39,8 @@ namespace mixt {
 /**
  * The learn algorithm is encapsulated in this function.
  * A SEM is used to estimate the parameters. Then a Gibbs to impute data, partition,...
+ * When nSemChain > 1 in algo, several SEM are run from independent initializations on separate threads, and the Gibbs
+ * continues the one with the highest completed log-likelihood at its last iteration.
  */
 template<typename Graph>
 void learn(const Graph& algo, const Graph& data, const Graph& desc, Graph& out) {
@@ -42,40 +49,98 @@ void learn(const Graph& algo, const Graph& data, const Graph& desc, Graph& out)
 #ifdef MC_VERBOSE
 	std::cout << "MixtComp, learn, version: " << version << std::endl;
 	std::cout << "Deterministic mode: " << deterministicMode() << std::endl;
-//	std::cout<< "Number of threads: " << omp_get_num_threads() << std::endl;
 #endif
 
 	Timer totalTimer("Total Run");
 
 	std::string warnLog; // string to log warnings
 
-	// Create the composer and read the data
-	MixtureComposer composer(algo);
-
-	Timer readTimer("Read Data");
-	warnLog += createAllMixtures(algo, desc, data, param, out, composer);
-	warnLog += composer.setDataParam(learning_, data, param, desc);
-	readTimer.finish();
+	readAlgoCount(algo, "nThread", nThreadDefault, nThreadMax, warnLog); // only validated here, the value is read by MixtureComposer
+	Index nSemChain = std::max(readAlgoCount(algo, "nSemChain", nSemChainDefault, nSemChainMax, warnLog), Index(1));
 
 	if (0 < warnLog.size()) {
 		out.add_payload( { }, "warnLog", warnLog);
 		return;
 	}
 
-	// Run the SEM strategy
+	// Create the composers, the data is only read and parsed by the first one, and copied in the others
+
+	std::vector<std::unique_ptr<MixtureComposer>> chain(nSemChain);
+
+	Timer readTimer("Read Data");
+	for (Index c = 0; c < nSemChain; ++c) {
+		chain[c].reset(new MixtureComposer(algo));
+		warnLog += createAllMixtures(algo, desc, data, param, out, *chain[c]);
+
+		if (c == 0) {
+			warnLog += chain[c]->setDataParam(learning_, data, param, desc);
+		} else {
+			warnLog += chain[c]->setDataParam(learning_, *chain[0], data, param, desc);
+		}
+
+		if (0 < warnLog.size()) {
+			out.add_payload( { }, "warnLog", warnLog);
+			return;
+		}
+	}
+	readTimer.finish();
+	NamedVector<Real> readTimeVariable = chain[0]->readTime(); // the data has been parsed by the first chain only
+
+	// Run the SEM strategy, one independent chain per composer, and keep the chain with the highest completed log-likelihood
 
-	std::pair<Real, Real> timeSEM;
+	std::vector<SemStrategy<Graph>> semStrategy; // algo is read here, and not in the parallel region
+	semStrategy.reserve(nSemChain);
+	for (Index c = 0; c < nSemChain; ++c) {
+		semStrategy.emplace_back(*chain[c], algo);
+	}
+
+	std::vector<std::pair<Real, Real>> timeChain(nSemChain);
+	std::vector<std::string> warnLogChain(nSemChain);
+	Vector<Real> lnCompLikChain(nSemChain);
+
+	Index nThread = chain[0]->nbThread();
+	Index nThreadChain = std::min(nSemChain, nThread); // threads of the loop over the chains
+	for (Index c = 0; c < nSemChain; ++c) { // the remaining threads are shared between the chains, for the loops of their composer
+		chain[c]->setNbThread(std::max(nThread / nSemChain, Index(1)));
+	}
+	int maxActiveLevels = setMaxActiveLevels(2); // the loops of a composer are nested in the loop over the chains
 
-	SemStrategy<Graph> semStrategy(composer, algo);
 	Timer semStratTimer("SEM Strategy Run");
-	warnLog += semStrategy.run(timeSEM);
+#pragma omp parallel for num_threads(nThreadChain) schedule(dynamic)
+	for (Index c = 0; c < nSemChain; ++c) {
+		warnLogChain[c] = semStrategy[c].run(timeChain[c]);
+		lnCompLikChain(c) = (0 < warnLogChain[c].size()) ? minInf : chain[c]->completedProbabilityLogRun()(chain[c]->completedProbabilityLogRun().size() - 1);
+	}
 	semStratTimer.finish();
 
-	if (0 < warnLog.size()) {
-		out.add_payload( { }, "warnLog", warnLog);
+	setMaxActiveLevels(maxActiveLevels);
+
+	Index best = nSemChain;
+	for (Index c = 0; c < nSemChain; ++c) {
+		if (0 == warnLogChain[c].size() && (best == nSemChain || lnCompLikChain(best) < lnCompLikChain(c))) {
+			best = c;
+		}
+	}
+
+	if (best == nSemChain) { // no chain could complete, the log of the first one is reported
+		out.add_payload( { }, "warnLog", warnLogChain[0]);
 		return;
 	}
 
+#ifdef MC_VERBOSE
+	std::cout << "SEM chains, lnCompletedLikelihood: " << itString(lnCompLikChain) << ", selected: " << best << std::endl;
+#endif
+
+	for (Index c = 0; c < nSemChain; ++c) { // the losing chains are not needed anymore
+		if (c != best) {
+			chain[c].reset();
+		}
+	}
+
+	MixtureComposer& composer = *chain[best];
+	composer.setNbThread(nThread); // the Gibbs of the selected chain uses all the threads
+	std::pair<Real, Real> timeSEM = timeChain[best];
+
 	// Run the Gibbs strategy
 
 	std::pair<Real, Real> timeGibbs;
@@ -111,6 +176,13 @@ void learn(const Graph& algo, const Graph& data, const Graph& desc, Graph& out)
 	out.add_payload( { "mixture", "runTime" }, "SEMRun", timeSEM.second);
 	out.add_payload( { "mixture", "runTime" }, "GibbsBurnIn", timeGibbs.first);
 	out.add_payload( { "mixture", "runTime" }, "GibbsRun", timeGibbs.second);
+	out.add_payload( { "mixture", "runTime" }, "nThread", composer.nbThread());
+	out.add_payload( { "mixture", "runTime" }, "readVariable", readTimeVariable);
+
+	out.add_payload( { "mixture", "semChain" }, "nChain", nSemChain);
+	out.add_payload( { "mixture", "semChain" }, "selected", best);
+	NamedVector<Real> lnCompLikChainNamed = { std::vector<std::string>(), lnCompLikChain };
+	out.add_payload( { "mixture", "semChain" }, "lnCompletedLikelihood", lnCompLikChainNamed);
 
 	composer.exportMixture(out);
 	composer.exportDataParam(out);
@@ -0,0 +1,215 @@
+/* MixtComp version 4  - july 2019
+ * Copyright (C) Inria - Université de Lille - CNRS*/
+
+/* This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ **/
+
+#ifndef LIB_RUN_LEARNSWEEP_H
+#define LIB_RUN_LEARNSWEEP_H
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <Composer/MixtureComposer.h>
+#include <Manager/createAllMixtures.h>
+#include <Statistic/RNG.h>
+#include <Strategy/GibbsStrategy.h>
+#include <Strategy/SEMStrategy.h>
+#include <Various/Timer.h>
+
+namespace mixt {
+
+/**
+ * Model selection over the number of classes. algo is the same as for learn, except that nClass is a vector of class
+ * counts. The data is read, parsed and checked once, by the composer of the first value of nClass, and copied in the
+ * composers of the others. The learn algorithm (SEM then Gibbs) is then run for every value of nClass, in parallel on up
+ * to nThread threads. The threads are shared between the fits, each composer gets max(1, nThread / nFit) threads for its
+ * own loops.
+ *
+ * The output contains a summary table (one column per criterion, one row per value of nClass) and, for each value of
+ * nClass, a compact result with the criteria and the estimated parameters, which is all that predict needs. The
+ * imputed data and the per individual quantities are not exported. Call learn on the selected nClass to get them.
+ */
+template<typename Graph>
+void learnSweep(const Graph& algo, const Graph& data, const Graph& desc, Graph& out) {
+	Graph param; // dummy Graph to be provided as unused argument in setDataParam in learning
+
+#ifdef MC_VERBOSE
+	std::cout << "MixtComp, learnSweep, version: " << version << std::endl;
+	std::cout << "Deterministic mode: " << deterministicMode() << std::endl;
+#endif
+
+	Timer totalTimer("Total Run");
+
+	std::string warnLog; // string to log warnings
+
+	std::vector<Index> vecNClass = algo.template get_payload<std::vector<Index>>( { }, "nClass");
+	Index nFit = vecNClass.size();
+
+	if (nFit == 0) {
+		warnLog += "learnSweep, nClass must contain at least one number of classes." + eol;
+	}
+
+	if (std::set<Index>(vecNClass.begin(), vecNClass.end()).size() != nFit) {
+		warnLog += "learnSweep, nClass must not contain the same number of classes twice." + eol;
+	}
+
+	readAlgoCount(algo, "nThread", nThreadDefault, nThreadMax, warnLog); // only validated here, the value is read by MixtureComposer
+
+	if (0 < warnLog.size()) {
+		out.add_payload( { }, "warnLog", warnLog);
+		return;
+	}
+
+	// Create the composers, the data is only read and parsed by the first one
+
+	std::vector<Graph> outFit(nFit); // the mixtures keep a reference to the Graph they export to, hence one Graph per fit
+	std::vector<std::unique_ptr<MixtureComposer>> composer(nFit);
+
+	Timer readTimer("Read Data");
+	for (Index f = 0; f < nFit; ++f) {
+		composer[f].reset(new MixtureComposer(algo, vecNClass[f]));
+		warnLog += createAllMixtures(algo, desc, data, param, outFit[f], *composer[f]);
+
+		if (f == 0) {
+			warnLog += composer[f]->setDataParam(learning_, data, param, desc);
+		} else {
+			warnLog += composer[f]->setDataParam(learning_, *composer[0], data, param, desc);
+		}
+
+		if (0 < warnLog.size()) {
+			out.add_payload( { }, "warnLog", warnLog);
+			return;
+		}
+	}
+	Real readTime = readTimer.finish();
+	NamedVector<Real> readTimeVariable = composer[0]->readTime(); // the data has been parsed by the first composer only
+
+	// Run the learn algorithm for every value of nClass. The strategies read algo in their constructors, hence the Graph is never accessed in the parallel region.
+
+	std::vector<SemStrategy<Graph>> semStrategy;
+	std::vector<GibbsStrategy<Graph>> gibbsStrategy;
+	semStrategy.reserve(nFit);
+	gibbsStrategy.reserve(nFit);
+	for (Index f = 0; f < nFit; ++f) {
+		semStrategy.emplace_back(*composer[f], algo);
+		gibbsStrategy.emplace_back(*composer[f], algo, 2);
+	}
+
+	Index nThread = composer[0]->nbThread();
+	Index nThreadFit = std::min(nFit, nThread); // threads of the loop over the fits
+	for (Index f = 0; f < nFit; ++f) { // the remaining threads are shared between the fits, for the loops of their composer
+		composer[f]->setNbThread(std::max(nThread / nFit, Index(1)));
+	}
+	int maxActiveLevels = setMaxActiveLevels(2); // the loops of a composer are nested in the loop over the fits
+
+	std::vector<std::string> warnLogFit(nFit);
+	Vector<Real> runTimeFit(nFit);
+
+	Timer fitTimer("Fit all nClass");
+#pragma omp parallel for num_threads(nThreadFit) schedule(dynamic)
+	for (Index f = 0; f < nFit; ++f) {
+		Timer runTimer;
+		std::pair<Real, Real> timeSEM;
+		std::pair<Real, Real> timeGibbs;
+
+		warnLogFit[f] = semStrategy[f].run(timeSEM);
+
+		if (0 == warnLogFit[f].size()) {
+			warnLogFit[f] = gibbsStrategy[f].run(timeGibbs);
+		}
+
+		if (0 == warnLogFit[f].size()) {
+			composer[f]->computeObservedProba();
+			composer[f]->setObservedProbaCache();
+		}
+
+		runTimeFit(f) = runTimer.finish();
+	}
+	fitTimer.finish();
+
+	setMaxActiveLevels(maxActiveLevels);
+
+	// Export the summary table and the compact results
+
+	std::vector<std::string> dummyNames;
+	NamedVector<Real> BIC = { dummyNames, Vector<Real>(nFit) };
+	NamedVector<Real> ICL = { dummyNames, Vector<Real>(nFit) };
+	NamedVector<Real> lnObservedLikelihood = { dummyNames, Vector<Real>(nFit) };
+	NamedVector<Real> lnCompletedLikelihood = { dummyNames, Vector<Real>(nFit) };
+	std::vector<Index> nbFreeParameters(nFit);
+
+	for (Index f = 0; f < nFit; ++f) {
+		std::string key = std::to_string(vecNClass[f]);
+
+		if (0 < warnLogFit[f].size()) {
+			BIC.vec_(f) = minInf;
+			ICL.vec_(f) = minInf;
+			lnObservedLikelihood.vec_(f) = minInf;
+			lnCompletedLikelihood.vec_(f) = minInf;
+			nbFreeParameters[f] = 0;
+
+			out.add_payload( { "res", key }, "warnLog", warnLogFit[f]);
+			continue;
+		}
+
+		BIC.vec_(f) = composer[f]->BIC();
+		ICL.vec_(f) = composer[f]->ICL();
+		lnObservedLikelihood.vec_(f) = composer[f]->lnObservedLikelihood();
+		lnCompletedLikelihood.vec_(f) = composer[f]->lnCompletedLikelihood();
+		nbFreeParameters[f] = composer[f]->nbFreeParameters();
+
+		out.add_payload( { "res", key, "mixture" }, "BIC", BIC.vec_(f));
+		out.add_payload( { "res", key, "mixture" }, "ICL", ICL.vec_(f));
+		out.add_payload( { "res", key, "mixture" }, "lnObservedLikelihood", lnObservedLikelihood.vec_(f));
+		out.add_payload( { "res", key, "mixture" }, "lnCompletedLikelihood", lnCompletedLikelihood.vec_(f));
+		out.add_payload( { "res", key, "mixture" }, "nbFreeParameters", nbFreeParameters[f]);
+		out.add_payload( { "res", key, "mixture" }, "runTime", runTimeFit(f));
+
+		composer[f]->exportDataParam(outFit[f]); // the data part is exported too, but only the param and type parts are kept
+
+		Graph paramG;
+		outFit[f].getSubGraph( { "variable", "param" }, paramG);
+		out.addSubGraph( { "res", key, "variable" }, "param", paramG);
+
+		Graph typeG;
+		outFit[f].getSubGraph( { "variable", "type" }, typeG);
+		out.addSubGraph( { "res", key, "variable" }, "type", typeG);
+
+		composer[f].reset(); // the results of this fit have been exported, free memory before the next one
+		outFit[f] = Graph();
+	}
+
+	out.add_payload( { "summary" }, "nClass", vecNClass);
+	out.add_payload( { "summary" }, "BIC", BIC);
+	out.add_payload( { "summary" }, "ICL", ICL);
+	out.add_payload( { "summary" }, "lnObservedLikelihood", lnObservedLikelihood);
+	out.add_payload( { "summary" }, "lnCompletedLikelihood", lnCompletedLikelihood);
+	out.add_payload( { "summary" }, "nbFreeParameters", nbFreeParameters);
+	out.add_payload( { "summary" }, "warnLog", warnLogFit);
+
+	Real runTime = totalTimer.finish();
+
+	out.add_payload( { "runTime" }, "total", runTime);
+	out.add_payload( { "runTime" }, "read", readTime);
+	out.add_payload( { "runTime" }, "readVariable", readTimeVariable);
+	out.add_payload( { "runTime" }, "nThread", nThread);
+
+	out.addSubGraph( { }, "algo", algo);
+}
+
+}
+
+#endif
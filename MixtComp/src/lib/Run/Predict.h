@@ -42,13 +42,19 @@ void predict(const Graph& algo, const Graph& data, const Graph& desc, const Grap
 #ifdef MC_VERBOSE
 	std::cout << "MixtComp, predict, version: " << version << std::endl;
 	std::cout << "Deterministic mode: " << deterministicMode() << std::endl;
-//	std::cout<< "Number of threads: " << omp_get_num_threads() << std::endl;
 #endif
 
 	Timer totalTimer("Total Run");
 
 	std::string warnLog; // string to log warnings
 
+	readAlgoCount(algo, "nThread", nThreadDefault, nThreadMax, warnLog); // only validated here, the value is read by MixtureComposer
+
+	if (0 < warnLog.size()) {
+		out.add_payload({}, "warnLog", warnLog);
+		return;
+	}
+
 	// Create the composer and read the data
 
 	MixtureComposer composer(algo);
@@ -89,6 +95,8 @@ void predict(const Graph& algo, const Graph& data, const Graph& desc, const Grap
 	out.add_payload( { "mixture", "runTime" }, "total", runTime);
 	out.add_payload( { "mixture", "runTime" }, "GibbsBurnIn", timeGibbs.first);
 	out.add_payload( { "mixture", "runTime" }, "GibbsRun", timeGibbs.second);
+	out.add_payload( { "mixture", "runTime" }, "nThread", composer.nbThread());
+	out.add_payload( { "mixture", "runTime" }, "readVariable", composer.readTime());
 
 	composer.exportMixture(out);
 	composer.exportDataParam(out);
@@ -30,8 +30,7 @@
 
 namespace mixt {
 
-ExponentialStatistic::ExponentialStatistic() :
-		rng_(seed(this)) {
+ExponentialStatistic::ExponentialStatistic() {
 }
 
 Real ExponentialStatistic::cdf(Real x, Real lambda) const {
@@ -48,8 +47,8 @@ Real ExponentialStatistic::pdf(Real x, Real lambda) const {
 
 Real ExponentialStatistic::sample(Real lambda) {
 	boost::random::exponential_distribution<> expo(lambda);
-	boost::variate_generator<boost::random::mt19937&,
-			boost::random::exponential_distribution<> > generator(rng_, expo);
+	boost::variate_generator<Philox4x32&,
+			boost::random::exponential_distribution<> > generator(threadRNG(), expo);
 	Real x = generator();
 	return x;
 }
@@ -44,9 +44,6 @@ class ExponentialStatistic
 
     /** Sample a value from an Exponential law with rate lambda */
     Real sample(Real lambda);
-  private:
-    /** Random number generator */
-    boost::random::mt19937 rng_;
 };
 
 } // namespace mixt
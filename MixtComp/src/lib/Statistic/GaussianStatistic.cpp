@@ -30,8 +30,7 @@
 
 namespace mixt {
 
-GaussianStatistic::GaussianStatistic() :
-		rng_(seed(this)) {
+GaussianStatistic::GaussianStatistic() {
 }
 
 Real GaussianStatistic::cdf(Real x, Real mean, Real sd) const {
@@ -53,8 +52,8 @@ Real GaussianStatistic::pdf(Real x, Real mean, Real sd) const {
 
 Real GaussianStatistic::sample(Real mean, Real sd) {
 	boost::normal_distribution<> norm(mean, sd);
-	boost::variate_generator<boost::mt19937&, boost::normal_distribution<> > generator(
-			rng_, norm);
+	boost::variate_generator<Philox4x32&, boost::normal_distribution<> > generator(
+			threadRNG(), norm);
 	Real x = generator();
 	return x;
 }
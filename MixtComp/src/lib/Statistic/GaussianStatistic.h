@@ -91,9 +91,6 @@ class GaussianStatistic {
     Real sideSampler(Real lower, Real upper);
 
   private:
-    /** Random number generator */
-    boost::mt19937 rng_;
-
     UniformStatistic uniform_;
 
     ExponentialStatistic exponential_;
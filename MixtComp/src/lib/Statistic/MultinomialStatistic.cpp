@@ -27,7 +27,7 @@ namespace mixt {
 
 int MultinomialStatistic::sampleInt(int low, int high) {
 	std::uniform_int_distribution<int> uni_(low, high);
-	int x = uni_(rng_);
+	int x = uni_(threadRNG());
 	return x;
 }
 
@@ -35,26 +35,13 @@
 namespace mixt {
 
 class MultinomialStatistic {
-
-private:
-/** Random number generator */
-std::mt19937 rng_;
-
-std::uniform_real_distribution<Real> uni_;
-
-// std::random_number_generator<std::mt19937> g_;
-
-// boost::variate_generator<boost::random::mt19937&,
-// 		boost::random::uniform_real_distribution<> > generator_;
-
 public:
-	MultinomialStatistic()
-	: rng_(seed(this)),
-	  uni_(0.0, 1.0) {}
+	MultinomialStatistic() {}
 
 	/** Sample a value from a binomial law with  */
 	int sampleBinomial(Real proportion) {
-		if (uni_(rng_) < proportion) {
+		std::uniform_real_distribution<Real> uni(0.0, 1.0);
+		if (uni(threadRNG()) < proportion) {
 			return 1;
 		} else {
 			return 0;
@@ -64,7 +51,8 @@ public:
 	/** Sample a value from a multinomial law with coefficient of modalities provided */
 	template<typename T>
 	int sample(const T& proportion) {
-		Real x = uni_(rng_);
+		std::uniform_real_distribution<Real> uni(0.0, 1.0);
+		Real x = uni(threadRNG());
 
 		Real cumProb = 0.; // cumulative probability
 		int index = 0;
@@ -81,7 +69,7 @@ public:
 
 	template<typename T>
 	void shuffle(T& data) {
-		std::shuffle(data.begin(), data.end(), rng_);
+		std::shuffle(data.begin(), data.end(), threadRNG());
 	}
 
 	template<typename T>
@@ -20,6 +20,7 @@
  *  Authors:    Vincent KUBICKI <vincent.kubicki@inria.fr>
  **/
 
+#include <Statistic/RNG.h>
 #include <Various/Constants.h>
 #include <cstddef>
 #include <cstdlib>
@@ -48,4 +49,65 @@ int deterministicInitialSeed() {
 	}
 }
 
+namespace {
+
+const std::uint32_t philoxM0 = 0xD2511F53;
+const std::uint32_t philoxM1 = 0xCD9E8D57;
+const std::uint32_t philoxW0 = 0x9E3779B9;
+const std::uint32_t philoxW1 = 0xBB67AE85;
+const int philoxNRound = 10;
+
+}
+
+Philox4x32::Philox4x32() {
+	setStream(seed(this), 0, 0, 0);
+}
+
+Philox4x32::Philox4x32(std::uint64_t seed, Index epoch, Index ind, Index var) {
+	setStream(seed, epoch, ind, var);
+}
+
+void Philox4x32::setStream(std::uint64_t seed, Index epoch, Index ind, Index var) {
+	key_[0] = std::uint32_t(seed);
+	key_[1] = std::uint32_t(seed >> 32);
+	ctr_[0] = 0;
+	ctr_[1] = std::uint32_t(epoch);
+	ctr_[2] = std::uint32_t(ind);
+	ctr_[3] = std::uint32_t(var);
+	index_ = 4; // block_ is generated at first draw
+}
+
+void Philox4x32::generateBlock() {
+	std::array<std::uint32_t, 4> x = ctr_;
+	std::array<std::uint32_t, 2> k = key_;
+
+	for (int r = 0; r < philoxNRound; ++r) {
+		std::uint64_t p0 = std::uint64_t(philoxM0) * x[0];
+		std::uint64_t p1 = std::uint64_t(philoxM1) * x[2];
+		x = { std::uint32_t(p1 >> 32) ^ x[1] ^ k[0], std::uint32_t(p1), std::uint32_t(p0 >> 32) ^ x[3] ^ k[1], std::uint32_t(p0) };
+		k[0] += philoxW0;
+		k[1] += philoxW1;
+	}
+
+	block_ = x;
+	index_ = 0;
+	++ctr_[0];
+}
+
+Philox4x32& threadRNG() {
+	static thread_local Philox4x32 rng;
+	return rng;
+}
+
+const Index RNGStream::all = 0xFFFFFFFF;
+
+RNGStream::RNGStream(std::uint64_t seed, Index epoch, Index ind, Index var) :
+		saved_(threadRNG()) {
+	threadRNG().setStream(seed, epoch, ind, var);
+}
+
+RNGStream::~RNGStream() {
+	threadRNG() = saved_;
+}
+
 } // namespace mixt
@@ -23,9 +23,12 @@
 #ifndef RNG_H
 #define RNG_H
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <time.h>
 
+#include <LinAlg/Typedef.h>
 #include <Various/Constants.h>
 
 namespace mixt {
@@ -47,6 +50,82 @@ std::size_t seed(const T* const p_caller) {
 	}
 }
 
+/**
+ * Counter-based random engine, Philox4x32-10 from Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11.
+ * A draw is a pure function of the key (the seed) and of a 128 bits counter, there is no sequential state to share.
+ * The counter is split in a stream identifier (epoch, individual, variable) and a draw index in the stream. Different
+ * streams are statistically independent, and selecting a stream is as cheap as writing three integers.
+ *
+ * It models UniformRandomBitGenerator, and can be used with the std:: and boost:: distributions.
+ */
+class Philox4x32 {
+public:
+	typedef std::uint32_t result_type;
+
+	Philox4x32();
+
+	Philox4x32(std::uint64_t seed, Index epoch, Index ind, Index var);
+
+	static constexpr result_type min() {
+		return 0;
+	}
+
+	static constexpr result_type max() {
+		return 0xFFFFFFFF;
+	}
+
+	result_type operator()() {
+		if (index_ == 4) {
+			generateBlock();
+		}
+		return block_[index_++];
+	}
+
+	/** Restart the engine at the beginning of the stream (seed, epoch, ind, var). */
+	void setStream(std::uint64_t seed, Index epoch, Index ind, Index var);
+
+private:
+	/** Encrypt the counter to fill block_, then increment the draw index. */
+	void generateBlock();
+
+	std::array<std::uint32_t, 2> key_;
+
+	/** ctr_[0] is the draw index, ctr_[1], ctr_[2] and ctr_[3] identify the stream */
+	std::array<std::uint32_t, 4> ctr_;
+
+	std::array<std::uint32_t, 4> block_;
+
+	int index_;
+};
+
+/**
+ * Engine used by all the Statistic objects in the calling thread. Statistic objects do not own an engine, so that an
+ * object shared between threads, for example a sampler in a mixture, does not cause a data race.
+ */
+Philox4x32& threadRNG();
+
+/**
+ * Select the stream of threadRNG() for the duration of the scope, the previous state of the engine is restored at
+ * destruction. MixtureComposer opens one stream per individual or per variable in its parallel loops, hence the draws
+ * do not depend on which thread executes an iteration, and results are identical for any number of threads.
+ */
+class RNGStream {
+public:
+	/** Used in place of ind or var when the stream is not specific to an individual or a variable. */
+	static const Index all;
+
+	RNGStream(std::uint64_t seed, Index epoch, Index ind, Index var);
+
+	~RNGStream();
+
+	RNGStream(const RNGStream&) = delete;
+
+	RNGStream& operator=(const RNGStream&) = delete;
+
+private:
+	Philox4x32 saved_;
+};
+
 } // namespace mixt
 
 #endif
@@ -30,8 +30,7 @@
 namespace mixt
 {
 
-UniformIntStatistic::UniformIntStatistic() :
-    rng_(seed(this))
+UniformIntStatistic::UniformIntStatistic()
 {}
 
 Real UniformIntStatistic::cdf(int x, int min, int max) const
@@ -53,8 +52,8 @@ int UniformIntStatistic::sample(int min, int max)
 {
 	boost::random::uniform_int_distribution<> uni(min, max);
 
-	boost::variate_generator<boost::random::mt19937&,
-	                         boost::random::uniform_int_distribution<> > generator(rng_, uni);
+	boost::variate_generator<Philox4x32&,
+	                         boost::random::uniform_int_distribution<> > generator(threadRNG(), uni);
 	Real x = generator();
   	return x;
 }
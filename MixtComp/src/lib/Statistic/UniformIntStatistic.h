@@ -50,9 +50,6 @@ class UniformIntStatistic
      */
     int sample(int min, int max);
 
-  private:
-    /** Random number generator */
-    boost::random::mt19937 rng_;
 };
 
 } // namespace mixt
@@ -30,8 +30,7 @@
 namespace mixt
 {
 
-UniformStatistic::UniformStatistic() :
-    rng_(seed(this))
+UniformStatistic::UniformStatistic()
 {}
 
 Real UniformStatistic::cdf(Real x,
@@ -61,8 +60,8 @@ Real UniformStatistic::sample(Real min,
 {
   boost::random::uniform_real_distribution<> uni(min,
                                                  max);
-  boost::variate_generator<boost::random::mt19937&,
-                           boost::random::uniform_real_distribution<> > generator(rng_,
+  boost::variate_generator<Philox4x32&,
+                           boost::random::uniform_real_distribution<> > generator(threadRNG(),
                                                                                   uni);
   Real x = generator();
   return x;
@@ -52,9 +52,6 @@ class UniformStatistic
      */
     Real sample(Real min,
                 Real max);
-  private:
-    /** Random number generator */
-    boost::random::mt19937 rng_;
 };
 
 } // namespace mixt
@@ -40,28 +40,28 @@ template<typename Graph>
 class GibbsStrategy {
 public:
 	/** default constructor.
+	 *  As in SemStrategy, the parameters are read from algo here, so that run can be called from a parallel region.
 	 *  @param p_composer the model to estimate
 	 **/
 	GibbsStrategy(MixtureComposer& composer, const Graph& algo, Index startGroup) :
-			composer_(composer), algo_(algo), startGroup_(startGroup) {
+			composer_(composer), nSemTry_(algo.template get_payload<Index>( { }, "nSemTry")), nbGibbsBurnInIter_(
+					algo.template get_payload<Index>( { }, "nbGibbsBurnInIter")), nbGibbsIter_(algo.template get_payload<Index>( { }, "nbGibbsIter")), startGroup_(
+					startGroup) {
 	}
 
 	/** run the strategy */
 	std::string run(std::pair<Real, Real>& time) {
 		std::string warnLog;
-		Index nSemTry = algo_.template get_payload<Index>( { }, "nSemTry");
-		Index nbGibbsBurnInIter = algo_.template get_payload<Index>( { }, "nbGibbsBurnInIter");
-		Index nbGibbsIter = algo_.template get_payload<Index>( { }, "nbGibbsIter");
 
 		try {
-			for (Index n = 0; n < nSemTry; ++n) {
+			for (Index n = 0; n < nSemTry_; ++n) {
 				warnLog = composer_.initializeLatent();
 				if (0 < warnLog.size())
 					continue;
 
-				runGibbs(burnIn_, nbGibbsBurnInIter, 0 + startGroup_, 1 + startGroup_, time.first);
+				runGibbs(burnIn_, nbGibbsBurnInIter_, 0 + startGroup_, 1 + startGroup_, time.first);
 
-				runGibbs(run_, nbGibbsIter, 1 + startGroup_, 1 + startGroup_, time.second);
+				runGibbs(run_, nbGibbsIter_, 1 + startGroup_, 1 + startGroup_, time.second);
 
 				return "";
 			}
@@ -106,7 +106,9 @@ protected:
 	/** reference on the main model */
 	MixtureComposer& composer_;
 
-	const Graph& algo_;
+	Index nSemTry_;
+	Index nbGibbsBurnInIter_;
+	Index nbGibbsIter_;
 
 	/** To help differentiate between a starting Gibbs, and a Gibbs that follows a SEM */
 	Index startGroup_;
@@ -51,25 +51,22 @@ class SemStrategy {
 
 public:
 	/** default constructor.
+	 *  The parameters are read from algo here, so that run does not access the Graph and can be called from a parallel region.
 	 *  @param p_composer the model to estimate
 	 **/
 	SemStrategy(MixtureComposer& composer, const Graph& algo) :
-			composer_(composer), algo_(algo) {
+			composer_(composer), nSemTry_(algo.template get_payload<Index>( { }, "nSemTry")), nInitPerClass_(
+					algo.template get_payload<Index>( { }, "nInitPerClass")), nbBurnInIter_(algo.template get_payload<Index>( { }, "nbBurnInIter")), nbIter_(
+					algo.template get_payload<Index>( { }, "nbIter")), nStableCriterion_(algo.template get_payload<Index>( { }, "nStableCriterion")), ratioStableCriterion_(
+					algo.template get_payload<Real>( { }, "ratioStableCriterion")) {
 	}
 
 	/** run the strategy */
 	std::string run(std::pair<Real, Real>& time) {
 		std::string warnLog;
 
-		Index nSemTry = algo_.template get_payload<Index>( { }, "nSemTry");
-		Index nInitPerClass = algo_.template get_payload<Index>( { }, "nInitPerClass");
-		Index nbBurnInIter = algo_.template get_payload<Index>( { }, "nbBurnInIter");
-		Index nbIter = algo_.template get_payload<Index>( { }, "nbIter");
-		Index nStableCriterion = algo_.template get_payload<Index>( { }, "nStableCriterion");
-		Real ratioStableCriterion = algo_.template get_payload<Real>( { }, "ratioStableCriterion");
-
 		try {
-			for (Index n = 0; n < nSemTry; ++n) {
+			for (Index n = 0; n < nSemTry_; ++n) {
 #ifdef MC_VERBOSE
 				std::cout << "SemStrategy::run, attempt n: " << n << std::endl;
 #endif
@@ -86,7 +83,7 @@ public:
 				//		p_composer_->printClassInd();
 
 				composer_.initParam(); // initialize iterative estimators
-				warnLog = composer_.initParamSubPartition(nInitPerClass); // initialize parameters for each model, usually singling out an observation as the center of each class
+				warnLog = composer_.initParamSubPartition(nInitPerClass_); // initialize parameters for each model, usually singling out an observation as the center of each class
 				if (0 < warnLog.size()) {
 #ifdef MC_VERBOSE
 					std::cout << "initParam failed." << std::endl;
@@ -109,11 +106,11 @@ public:
 				std::cout << "SEM initialization complete. SEM run can start." << std::endl;
 #endif
 
-				warnLog = runSEM(burnIn_, nbBurnInIter, 0, 3, ratioStableCriterion, nStableCriterion, time.first); // group, groupMax
+				warnLog = runSEM(burnIn_, nbBurnInIter_, 0, 3, ratioStableCriterion_, nStableCriterion_, time.first); // group, groupMax
 				if (0 < warnLog.size())
 					continue; // a non empty warnLog signals a problem in the SEM run, hence there is no need to push the execution further
 
-				warnLog = runSEM(run_, nbIter, 1, 3, ratioStableCriterion, nStableCriterion, time.second); // group, groupMax
+				warnLog = runSEM(run_, nbIter_, 1, 3, ratioStableCriterion_, nStableCriterion_, time.second); // group, groupMax
 				if (0 < warnLog.size())
 					continue;
 
@@ -189,7 +186,12 @@ private:
 	/** reference on the main model */
 	MixtureComposer& composer_;
 
-	const Graph& algo_;
+	Index nSemTry_;
+	Index nInitPerClass_;
+	Index nbBurnInIter_;
+	Index nbIter_;
+	Index nStableCriterion_;
+	Real ratioStableCriterion_;
 };
 
 }  // namespace mixt
@@ -66,6 +66,11 @@ const Index nbGibbsIniISR = 100;
 
 const int nbSampleObserved = 10000;
 
+const int nbPosExactRank = 12;
+const int nbSampleObservedRankMax = 100 * nbSampleObserved;
+const Real unseenMassRank = 0.01;
+const int nbPosInsertionAG = 16;
+
 const Index maxIterationOptim = 50;
 const Real relTolOptim = 0.0001;
 
@@ -73,6 +78,24 @@ const std::string rankPosSep = ",";
 
 const Index nCompletedInitTry = 1000;
 
+const Index nThreadDefault = 1;
+
+const Index nThreadMax = 1024;
+
+const Index nSemChainDefault = 1;
+
+const Index nSemChainMax = 1024;
+
+const Index nIndPerBlock = 256;
+
+const Index nSuffStatUpdate = 50;
+
+const int logFacTableSize = 1024;
+
+const Index nParamStatBuffer = 100;
+
+const Index nDataStatReservoir = 64;
+
 // const Real poissonInitMinAlpha = 0.5;
 
 } // namespace mixt
@@ -59,6 +59,11 @@ extern const Index nbGibbsIniISR; // number of iterations in the initializing Gi
 
 extern const int nbSampleObserved; // number of sample per class to estimate the observed probability, for example in Ordinal or Rank data
 
+extern const int nbPosExactRank; // maximum number of positions for which the observed probability of a Rank is computed exactly instead of being estimated by sampling
+extern const int nbSampleObservedRankMax; // maximum number of samples per class used to estimate the observed probability of a Rank
+extern const Real unseenMassRank; // sampling of the observed probability of a Rank stops when the estimated probability of the rankings that have not been sampled is below this value
+extern const int nbPosInsertionAG; // below this number of positions, RankISRIndividual::AG replays the insertion sort, which is then faster than counting the comparisons
+
 extern const Index maxIterationOptim; // maximum number of evaluation of cost function for optimization in Functional and in Weibull
 extern const Real relTolOptim;
 
@@ -66,6 +71,26 @@ extern const std::string rankPosSep; // separator used in Rank positions
 
 extern const Index nCompletedInitTry;
 
+extern const Index nThreadDefault; // number of threads used in MixtureComposer parallel loops when nThread is not provided in algo
+
+extern const Index nThreadMax; // largest value accepted for the nThread field of algo
+
+extern const Index nSemChainDefault; // number of independent SEM chains run in learn when nSemChain is not provided in algo
+
+extern const Index nSemChainMax; // largest value accepted for the nSemChain field of algo
+
+extern const Index nIndPerBlock; // number of individuals per block in the batched likelihood computations of MixtureComposer
+
+extern const Index nSuffStatUpdate; // number of incremental updates of the sufficient statistics of the simple models between two full computations, see ClassSuffStat
+
+extern const int logFacTableSize; // logFac(n) is tabulated for 0 <= n < logFacTableSize
+
+extern const Index nParamStatBuffer; // number of SEM iterations kept exactly by ConfIntParamStat in streamingParamStat_ mode before switching to the quantile sketches
+
+extern const Index nDataStatReservoir; // maximum number of sampled values kept per missing value by ConfIntDataStat in reservoirDataStat_ mode
+
+const int logToMultiChunk = 256; // number of rows processed at once in logToMultiRows, compile-time constant since it sizes stack storage
+
 // extern const Real poissonInitMinAlpha; // minimal value that can be used for alpha estimation in a Poisson distribution
 
 } // namespace mixt
@@ -47,6 +47,25 @@ enum RunType {
   run_,
 };
 
+/** Storage of the parameters during the SEM run phase, see ConfIntParamStat */
+enum ParamStatMode {
+  exactParamStat_, // full trace of the parameters, the quantiles are exact
+  streamingParamStat_ // constant size quantile sketches, no trace
+};
+
+/** Storage of the sampled missing values during the Gibbs run phase, see ConfIntDataStat */
+enum DataStatMode {
+  exactDataStat_, // every iteration is kept
+  reservoirDataStat_ // fixed size systematic subsample of the iterations
+};
+
+/** Content of a cell of a data column, see DataColumn in IOFunctions.h */
+enum CellType {
+  stringCell_, // parsed with MisValParser, can describe any missing value
+  numberCell_, // present value
+  missingCell_ // completely missing value, for example NaN, NA or null
+};
+
 } // namespace mixt
 
 #endif /* ENUM_H_ */
@@ -26,6 +26,10 @@
 #include <iostream>
 #include <fstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace mixt {
 
 void writeProgress(int group, int groupMax, int iteration, int iterationMax) {
@@ -44,4 +48,25 @@ void writeProgress(int group, int groupMax, int iteration, int iterationMax) {
 	myfile.close();
 }
 
+Index effectiveNThread(Index nThread) {
+#ifdef _OPENMP
+	if (nThread == 0) {
+		return omp_get_max_threads(); // OMP_NUM_THREADS if set, otherwise the number of available cores
+	}
+	return nThread;
+#else
+	return 1;
+#endif
+}
+
+int setMaxActiveLevels(int nLevel) {
+#ifdef _OPENMP
+	int previous = omp_get_max_active_levels();
+	omp_set_max_active_levels(nLevel);
+	return previous;
+#else
+	return nLevel;
+#endif
+}
+
 } // namespace mixt
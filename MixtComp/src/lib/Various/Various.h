@@ -23,10 +23,56 @@
 #ifndef VARIOUS_H_
 #define VARIOUS_H_
 
+#include <sstream>
+#include <string>
+
+#include <LinAlg/Typedef.h>
+#include <Various/Constants.h>
+
 namespace mixt {
 
 void writeProgress(int group, int groupMax, int iteration, int iterationMax);
 
+/**
+ * Number of threads that will be used by the parallel loops of MixtureComposer.
+ * @param nThread number of threads requested by the user, 0 to let OpenMP decide (OMP_NUM_THREADS or every available core)
+ * @return number of threads, always 1 if MixtComp was compiled without OpenMP
+ */
+Index effectiveNThread(Index nThread);
+
+/**
+ * Set the maximum number of nested active parallel regions. Used to run the loops of each MixtureComposer in parallel
+ * inside a parallel loop over several composers.
+ * @param nLevel maximum number of nested active parallel regions
+ * @return previous maximum number of nested active parallel regions, to be restored by the caller
+ */
+int setMaxActiveLevels(int nLevel);
+
+/**
+ * Read an optional count in algo. The value is read as a signed integer, so that a negative value is detected instead
+ * of wrapping around when converted to Index.
+ * @param name name of the field in algo
+ * @param defaultVal value returned when the field is absent or invalid
+ * @param maxVal largest accepted value
+ * @param[out] warnLog a message is appended if the value is negative or larger than maxVal
+ */
+template<typename Graph>
+Index readAlgoCount(const Graph& algo, const std::string& name, Index defaultVal, Index maxVal, std::string& warnLog) {
+	if (!algo.exist_payload( { }, name)) {
+		return defaultVal;
+	}
+
+	Integer val = algo.template get_payload<Integer>( { }, name);
+	if (val < 0 || Integer(maxVal) < val) {
+		std::stringstream sstm;
+		sstm << "algo, " << name << " is " << val << " but must be between 0 and " << maxVal << "." << eol;
+		warnLog += sstm.str();
+		return defaultVal;
+	}
+
+	return Index(val);
+}
+
 } // namespace mixt
 
 #endif /* VARIOUS_H_ */
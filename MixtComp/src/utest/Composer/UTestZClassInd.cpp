@@ -57,7 +57,7 @@ TEST(ZClassInd, setZi) {
 		EXPECT_EQ(outZi.misCount_(i), 0);
 
 
-	Vector<std::set<Index> > classInd = zclass.classInd();
+	Vector<std::vector<Index>> classInd = zclass.classInd();
 	ASSERT_EQ(classInd.size(), nClass);
 	Index i = 0;
 	for(auto f : classInd[0]) {
@@ -71,7 +71,8 @@ TEST(ZClassInd, setZi) {
 
 
 	// check setters
-	zclass.setZAndClassInd(0, 1);
+	zclass.setZ(0, 1);
+	zclass.computeClassInd();
 	EXPECT_EQ(zclass.zi().data_[0], 1);
 
 	classInd = zclass.classInd();
@@ -196,3 +197,27 @@ TEST(ZClassInd, checkMissingType) {
 }
 
 
+
+TEST(ZClassInd, movedInd) {
+	std::vector<std::string> zi(10, "1");
+
+	ZClassInd zclass;
+	zclass.setIndClass(10, 2);
+	ASSERT_EQ(zclass.setZi(zi).size(), 0);
+	EXPECT_EQ(zclass.movedInd().size(), 10); // the whole partition has been read
+	zclass.clearMovedInd();
+
+	zclass.setZ(3, 1);
+	zclass.setZ(7, 0); // no move
+	zclass.computeClassInd();
+	zclass.setZ(3, 0); // moved back, still listed once
+	zclass.setZ(8, 1);
+	zclass.computeClassInd();
+	EXPECT_EQ(zclass.movedInd(), std::vector<Index>({ 3, 8 }));
+
+	zclass.clearMovedInd();
+	EXPECT_EQ(zclass.movedInd().size(), 0);
+	zclass.setZ(3, 1);
+	zclass.computeClassInd();
+	EXPECT_EQ(zclass.movedInd(), std::vector<Index>({ 3 }));
+}
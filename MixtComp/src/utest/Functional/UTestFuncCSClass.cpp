@@ -77,8 +77,8 @@ TEST(FuncCSClass, optimOneclassOneInd) {
 	Vector<FunctionCS> data(1);
 	data(0).setVal(t, x, w);
 
-	std::set<Index> setInd;
-	setInd.insert(0);
+	std::vector<Index> setInd;
+	setInd.push_back(0);
 
 	FuncCSClass funcClass(data, 0.95);
 	funcClass.setSize(nSub, nCoeff);
@@ -117,7 +117,7 @@ TEST(FuncCSClass, optimOneclassMultiIndAlphaBetaSd) {
 	sd << 0.1, 1.;
 
 	Vector<FunctionCS> data(nInd);
-	std::set<Index> setInd;
+	std::vector<Index> setInd;
 
 	for (Index ind = 0; ind < nInd; ++ind) {
 		Vector<std::set<Index> > w(nSub);
@@ -150,7 +150,7 @@ TEST(FuncCSClass, optimOneclassMultiIndAlphaBetaSd) {
 
 		data(ind).setVal(t, x, w);
 		data(ind).computeVandermonde(nCoeff);
-		setInd.insert(ind);
+		setInd.push_back(ind);
 	}
 
 	FuncCSClass funcClass(data, 0.95);
@@ -178,7 +178,7 @@ TEST(FuncCSClass, checkNbDifferentValue) {
 	Real xMax = 35.;
 
 	Vector<FunctionCS> data(nInd);
-	std::set<Index> setInd;
+	std::vector<Index> setInd;
 	Real confidenceLevel = 0.95;
 
 	MultinomialStatistic multi;
@@ -197,7 +197,7 @@ TEST(FuncCSClass, checkNbDifferentValue) {
 
 		data(i).setVal(t, x, w);
 		if (multi.sampleInt(0, nClass - 1) == 0) {
-			setInd.insert(i);
+			setInd.push_back(i);
 		}
 	}
 
@@ -78,7 +78,7 @@ TEST(FuncCSComputation, regressionNoNoise) {
 
 TEST(FuncCSComputation, regressionNoise) {
 	Index nCoeff = 3;
-	Index nObs = 2000;
+	Index nObs = 50000;
 
 	Real xMin = -50.;
 	Real xMax = 50.;
@@ -115,7 +115,7 @@ TEST(FuncCSComputation, regressionNoise) {
 
 TEST(FuncCSComputation, subRegression) {
 	Index nCoeff = 3;
-	Index nObs = 15000;
+	Index nObs = 150000;
 	Index nSub = 3;
 
 	Real xMin = -50.;
@@ -417,8 +417,8 @@ TEST(FuncCSComputation, optimRealSimpleCase) {
 
 	Vector<FunctionCS> data(1);
 	data(0).setVal(t, y, w);
-	std::set<Index> setInd;
-	setInd.insert(0);
+	std::vector<Index> setInd;
+	setInd.push_back(0);
 
 	FuncCSProblem fp(nParam, data, setInd);
 
@@ -29,7 +29,7 @@ using namespace mixt;
  * Test if the FuncCSMixture compiles. As it is a template class, it needs to be instancied to be compiled. So here we go.
  */
 TEST(FuncCSMixture, compilation) {
-  Vector<std::set<Index> > classInd;
+  Vector<std::vector<Index>> classInd;
 
 //  FuncCSMixture<DataHandlerDummy,
 //                DataExtractorDummy,
@@ -66,3 +66,27 @@ TEST(MisValParser, reMissing) {
 
 	ASSERT_TRUE(v);
 }
+
+TEST(MisValParser, mixedColumn) {
+	MixedColumn col;
+	col.resize(5);
+	col.setNumber(0, 3.);
+	col.setString(1, "[1:4]");
+	col.setNumber(2, 2.7);
+	col.setString(4, "5");
+
+	AugmentedData<Vector<int>> augData;
+	std::string warnLog = StringToAugmentedData("var", col, augData, -1);
+
+	ASSERT_EQ(warnLog.size(), 0);
+	ASSERT_EQ(augData.data_(0), 2); // the offset is applied to the numbers too
+	ASSERT_EQ(augData.misData_(1).first, missingIntervals_);
+	ASSERT_EQ(augData.data_(2), 1); // truncated, as "2.7" would be
+	ASSERT_EQ(augData.misData_(3).first, missing_);
+	ASSERT_EQ(augData.data_(4), 4);
+
+	col.setNumber(3, std::numeric_limits<Real>::infinity());
+	warnLog = StringToAugmentedData("var", col, augData, -1);
+
+	ASSERT_LT(0, warnLog.size());
+}
@@ -84,3 +84,33 @@ TEST(Math, NewtonRaphsonRelTolConstraint) {
 
 	ASSERT_NEAR(sol, 0.0, 0.1);
 }
+
+TEST(Math, logToMultiRows) {
+	Index nRow = 600; // more than one chunk, and a partial last chunk
+	Index nCol = 4;
+	Real epsilon = 1e-12;
+
+	Matrix<Real> logProba(nRow, nCol);
+	for (Index i = 0; i < nRow; ++i) {
+		for (Index k = 0; k < nCol; ++k) {
+			logProba(i, k) = -1000.0 + std::sin(Real(3 * i + 7 * k)) * Real(i); // large and spread values, to check the stability
+		}
+	}
+	logProba(nRow - 1, 2) = minInf; // a class with a 0 probability
+
+	Matrix<Real> expectedProba(nRow, nCol);
+	Vector<Real> expectedLogNorm(nRow);
+	for (Index i = 0; i < nRow; ++i) {
+		expectedLogNorm(i) = expectedProba.row(i).logToMulti(logProba.row(i));
+	}
+
+	Vector<Real> logNorm;
+	logToMultiRows(logProba, logNorm);
+
+	for (Index i = 0; i < nRow; ++i) {
+		ASSERT_NEAR(logNorm(i), expectedLogNorm(i), epsilon * std::abs(expectedLogNorm(i)));
+		for (Index k = 0; k < nCol; ++k) {
+			ASSERT_NEAR(logProba(i, k), expectedProba(i, k), epsilon);
+		}
+	}
+}
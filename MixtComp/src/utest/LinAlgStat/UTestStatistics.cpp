@@ -155,3 +155,84 @@ TEST(Math, LogFactorial) {
 
 	ASSERT_EQ(expectedFactoValue.isApprox(factoValue), true);
 }
+
+TEST(Statistics, P2Quantile) {
+	Index nSample = 100000;
+	Vector<Real> prob(3);
+	prob << 0.5, 0.025, 0.975;
+
+	RNGStream stream(42, 0, 0, RNGStream::all); // private stream, the draws of the other tests are not shifted
+	GaussianStatistic normal;
+	Vector<Real> sampleVal(nSample);
+	std::vector<P2Quantile> sketch;
+	for (Index q = 0; q < prob.size(); ++q) {
+		sketch.emplace_back(prob(q));
+	}
+
+	for (Index i = 0; i < nSample; ++i) {
+		sampleVal(i) = normal.sample(0., 1.);
+		for (Index q = 0; q < prob.size(); ++q) {
+			sketch[q].add(sampleVal(i));
+		}
+	}
+
+	sampleVal.sort();
+	for (Index q = 0; q < prob.size(); ++q) {
+		ASSERT_NEAR(sampleVal(Index(prob(q) * nSample)), sketch[q].value(), 0.02);
+	}
+}
+
+TEST(Statistics, P2QuantileFewObservations) {
+	P2Quantile median(0.5);
+	median.add(3.);
+	ASSERT_EQ(median.value(), 3.);
+
+	median.add(1.);
+	median.add(2.);
+	ASSERT_EQ(median.value(), 2.);
+}
+
+/** The streaming quantiles of the parameters must be close to the exact ones, and no trace must be kept. */
+TEST(Statistics, ConfIntParamStatStreaming) {
+	Index nIter = 2000;
+	Vector<Real> paramExact(2);
+	Vector<Real> paramStreaming(2);
+	ConfIntParamStat<Vector<Real>> exact(paramExact, 0.95, exactParamStat_);
+	ConfIntParamStat<Vector<Real>> streaming(paramStreaming, 0.95, streamingParamStat_);
+
+	RNGStream stream(42, 0, 0, RNGStream::all);
+	GaussianStatistic normal;
+	for (Index iter = 0; iter < nIter; ++iter) {
+		paramExact << normal.sample(0., 1.), normal.sample(10., 2.);
+		paramStreaming = paramExact;
+		exact.sampleParam(iter, nIter - 1);
+		streaming.sampleParam(iter, nIter - 1);
+	}
+
+	ASSERT_EQ(exact.getLogStorage().cols(), nIter);
+	ASSERT_EQ(streaming.getLogStorage().cols(), 0);
+	ASSERT_EQ(streaming.getStatStorage().rows(), 2);
+	ASSERT_EQ(streaming.getStatStorage().cols(), 3);
+	ASSERT_TRUE(exact.getStatStorage().isApprox(streaming.getStatStorage(), 0.05));
+}
+
+/** A run that fits in the buffer of the streaming mode gets the exact quantiles. */
+TEST(Statistics, ConfIntParamStatStreamingShortRun) {
+	Index nIter = nParamStatBuffer / 2;
+	Vector<Real> paramExact(2);
+	Vector<Real> paramStreaming(2);
+	ConfIntParamStat<Vector<Real>> exact(paramExact, 0.95, exactParamStat_);
+	ConfIntParamStat<Vector<Real>> streaming(paramStreaming, 0.95, streamingParamStat_);
+
+	RNGStream stream(42, 0, 0, RNGStream::all);
+	GaussianStatistic normal;
+	for (Index iter = 0; iter < nIter; ++iter) {
+		paramExact << normal.sample(0., 1.), normal.sample(10., 2.);
+		paramStreaming = paramExact;
+		exact.sampleParam(iter, nIter - 1);
+		streaming.sampleParam(iter, nIter - 1);
+	}
+
+	ASSERT_EQ(streaming.getLogStorage().cols(), 0);
+	ASSERT_EQ(exact.getStatStorage(), streaming.getStatStorage());
+}
@@ -143,7 +143,7 @@ TEST(RankISRClass, sampleMu) {
 	rankIndividual.setObsData(obsData);
 
 	Vector<RankISRIndividual> data(nbInd); // will store the result of xGen
-	std::set<Index> classInd;
+	std::vector<Index> classInd;
 
 	RankVal mu = { 0, 3, 1, 2, 4 }; // position -> modality representation
 	Real pi = 0.7; // pi high enough to get mu, no matter the y obtained in removeMissing
@@ -154,7 +154,7 @@ TEST(RankISRClass, sampleMu) {
 
 		data(i) = rankIndividual;
 
-		classInd.insert(i);
+		classInd.push_back(i);
 	}
 
 	Vector<int> muVec(nbPos);
@@ -195,7 +195,7 @@ TEST(RankISRClass, mStep) {
 	rankIndividual.setObsData(obsData);
 
 	Vector<RankISRIndividual> data(nbInd); // will store the result of xGen
-	std::set<Index> setInd;
+	std::vector<Index> setInd;
 
 	RankVal mu = { 0, 3, 1, 2, 4 }; // position -> modality representation
 	Real pi = 0.75;
@@ -205,7 +205,7 @@ TEST(RankISRClass, mStep) {
 
 		data(i).removeMissing(); // shuffle the presentation order, to get the correct marginal distribution corresponding to (mu, pi)
 		data(i).xGen(mu, pi);
-		setInd.insert(i);
+		setInd.push_back(i);
 	}
 
 	Vector<int> muVec(nbPos);
@@ -255,3 +255,36 @@ TEST(RankISRClass, lnObservedProbability) {
 
 	ASSERT_EQ(rc.lnObservedProbability(0), 0.);
 }
+
+/** The observed probability of a partially observed individual is the sum of the exact probabilities of its
+ * completions. */
+TEST(RankISRClass, lnObservedProbabilityExact) {
+	int nbPos = 4;
+
+	Vector<int> x(nbPos);
+	x << 2, 0, 1, 3;
+	Vector<MisVal> obsData(nbPos, MisVal(present_, { }));
+	obsData(1) = MisVal(missing_, { });
+	obsData(2) = MisVal(missing_, { });
+
+	Vector<RankISRIndividual> data(1);
+	data(0).setNbPos(nbPos);
+	data(0).setO(x);
+	data(0).setObsData(obsData);
+
+	RankVal mu = { 1, 3, 0, 2 };
+	Real pi = 0.8;
+
+	RankISRClass rc(data, mu, pi);
+	ASSERT_FALSE(rc.sampleApproximationOfObservedProba());
+
+	rc.computeObservedProba();
+
+	RankVal completed0 = { 2, 0, 1, 3 };
+	RankVal completed1 = { 2, 1, 0, 3 };
+	Real expected = std::log(
+			std::exp(RankISRIndividual::lnMarginalProbability(completed0, mu, pi))
+					+ std::exp(RankISRIndividual::lnMarginalProbability(completed1, mu, pi)));
+
+	ASSERT_NEAR(rc.lnObservedProbability(0), expected, 1e-12);
+}
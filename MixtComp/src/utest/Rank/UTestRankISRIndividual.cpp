@@ -211,14 +211,14 @@ TEST(RankIndividual, observedProba) {
 	rv.setObsData(obsData);
 	rv.removeMissing();
 
-	std::map<RankVal, Real> proba;
+	std::unordered_map<RankVal, Real, RankValHash> proba;
 
 	rv.observedProba(mu, pi, proba);
 
 	RankVal muEst = proba.begin()->first;
 	Real probaEst = proba.begin()->second;
 
-	for (std::map<RankVal, Real>::const_iterator it = proba.begin(), itEnd = proba.end(); it != itEnd; ++it) {
+	for (std::unordered_map<RankVal, Real, RankValHash>::const_iterator it = proba.begin(), itEnd = proba.end(); it != itEnd; ++it) {
 #ifdef MC_DEBUG
 		std::cout << "RankVal: " << it->first << ", proba: " << it->second << std::endl;
 #endif
@@ -235,6 +235,135 @@ TEST(RankIndividual, observedProba) {
 	ASSERT_EQ(mu, muEst);
 }
 
+/** Compare the exact marginal probability of every x to the sum over the presentation orders of the joint
+ * probability, and check that the marginal probabilities sum to 1. */
+TEST(RankISRIndividual, lnMarginalProbability) {
+	int nbPos = 5;
+	RankVal mu = { 3, 0, 4, 1, 2 };
+	Real pi = 0.7;
+	int nbY = fac(nbPos);
+
+	std::set<int> remainingMod = { 0, 1, 2, 3, 4 };
+	std::vector<int> xVec = { 0, 1, 2, 3, 4 };
+	Real sumProba = 0.;
+
+	do {
+		RankVal x(nbPos);
+		x.setO(xVec);
+
+		RankISRIndividual ri(x);
+		Vector<Vector<int> > resVec(nbY);
+		Vector<Real> logProba(nbY);
+		Vector<int> vec(nbPos);
+		ri.recYgX(mu, pi, resVec, logProba, vec, remainingMod, 0, nbY, 0, nbPos); // joint log-probability of x and each presentation order
+
+		Real computed = RankISRIndividual::lnMarginalProbability(x, mu, pi);
+		ASSERT_NEAR(std::exp(computed), logProba.array().exp().sum(), 1e-12);
+		sumProba += std::exp(computed);
+	} while (std::next_permutation(xVec.begin(), xVec.end()));
+
+	ASSERT_NEAR(sumProba, 1., 1e-12);
+}
+
+/** AG, which counts the comparisons without replaying the insertion sort, must give the same results as the insertion sort. */
+TEST(RankISRIndividual, AGSameAsInsertion) {
+	RNGStream stream(42, 0, 0, RNGStream::all);
+	MultinomialStatistic multi;
+
+	for (int nbPos : { 1, 2, 3, 6, 16, 17, 40, 64, 65, 100, 300 }) {
+		Vector<MisVal> obsData(nbPos, MisVal(missing_, { }));
+		Vector<int> xVec(nbPos);
+		Vector<int> muVec(nbPos);
+
+		for (int r = 0; r < 50; ++r) {
+			RankISRIndividual ri(nbPos);
+			ri.setObsData(obsData);
+			ri.removeMissing(); // random presentation order
+
+			std::iota(xVec.begin(), xVec.end(), 0);
+			multi.shuffle(xVec);
+			ri.setO(xVec);
+
+			std::iota(muVec.begin(), muVec.end(), 0);
+			multi.shuffle(muVec);
+			RankVal mu(nbPos);
+			mu.setO(muVec);
+
+			int a, g, aExp, gExp;
+			ri.AG(mu, a, g);
+			ri.AGInsertion(mu, aExp, gExp);
+
+			ASSERT_EQ(a, aExp);
+			ASSERT_EQ(g, gExp);
+		}
+	}
+}
+
+/**
+ * The variations of a and g for the permutations of two adjacent elements of y_ or x_, and the counts of comparisons,
+ * must agree with AG.
+ */
+TEST(RankISRIndividual, deltaAGSameAsAG) {
+	RNGStream stream(42, 0, 0, RNGStream::all);
+	MultinomialStatistic multi;
+
+	for (int nbPos : { 2, 3, 6, 17, 40 }) {
+		Vector<MisVal> obsData(nbPos, MisVal(missing_, { }));
+		Vector<int> xVec(nbPos);
+		Vector<int> muVec(nbPos);
+
+		for (int r = 0; r < 20; ++r) {
+			RankISRIndividual ri(nbPos);
+			ri.setObsData(obsData);
+			ri.removeMissing(); // random presentation order
+
+			std::iota(xVec.begin(), xVec.end(), 0);
+			multi.shuffle(xVec);
+			ri.setO(xVec);
+
+			std::iota(muVec.begin(), muVec.end(), 0);
+			multi.shuffle(muVec);
+			RankVal mu(nbPos);
+			mu.setO(muVec);
+
+			int a, g;
+			ri.AG(mu, a, g);
+
+			Matrix<int> comparison(nbPos, nbPos);
+			comparison.setZero();
+			ri.comparisonCount(comparison);
+			int gComparison = 0;
+			for (int e = 0; e < nbPos; ++e) {
+				for (int f = 0; f < nbPos; ++f) {
+					if (mu.r()(e) < mu.r()(f)) {
+						gComparison += comparison(e, f);
+					}
+				}
+			}
+			ASSERT_EQ(a, comparison.sum());
+			ASSERT_EQ(g, gComparison);
+
+			for (int p = 0; p < nbPos - 1; ++p) {
+				int deltaA, deltaG, aPerm, gPerm;
+
+				ri.deltaAGX(mu, p, deltaA, deltaG);
+				ri.xModif().permutation(p);
+				ri.AG(mu, aPerm, gPerm);
+				ri.xModif().permutation(p);
+				ASSERT_EQ(a + deltaA, aPerm);
+				ASSERT_EQ(g + deltaG, gPerm);
+
+				ri.deltaAGY(mu, p, deltaA, deltaG);
+				std::swap(ri.yModif()(p), ri.yModif()(p + 1));
+				ri.AG(mu, aPerm, gPerm);
+				std::swap(ri.yModif()(p), ri.yModif()(p + 1));
+				ASSERT_EQ(a + deltaA, aPerm);
+				ASSERT_EQ(g + deltaG, gPerm);
+			}
+		}
+	}
+}
+
 TEST(RankISRIndividual, checkAcceptedTypeTrue) {
 	int nbPos;
 	std::vector<std::string> vecStr = { "0, 1, 3, 2" };
@@ -384,6 +513,84 @@ TEST(RankISRIndividual, enumCompletedPartial2) {
 	ASSERT_EQ(listCompleted.size(), 2);
 }
 
+/**
+ * nbCompleted must count the completions enumerated by forEachCompleted, which must be sorted, and the uniform sampling
+ * of removeMissing must reach all of them.
+ */
+TEST(RankISRIndividual, nbCompletedAndSampling) {
+	RNGStream stream(42, 0, 0, RNGStream::all);
+	MultinomialStatistic multi;
+	int nbPos = 6;
+
+	for (int r = 0; r < 50; ++r) {
+		Vector<int> xVec(nbPos);
+		std::iota(xVec.begin(), xVec.end(), 0);
+		multi.shuffle(xVec);
+
+		Vector<MisVal> obsData(nbPos);
+		for (int p = 0; p < nbPos; ++p) {
+			int type = multi.sampleInt(0, 2);
+			if (type == 0) {
+				obsData(p) = MisVal(present_, { });
+			} else if (type == 1) {
+				obsData(p) = MisVal(missing_, { });
+			} else { // the observed value and some others, sorted
+				std::vector<int> values;
+				for (int m = 0; m < nbPos; ++m) {
+					if (m == xVec(p) || multi.sampleInt(0, 1) == 1) {
+						values.push_back(m);
+					}
+				}
+				obsData(p) = MisVal(missingFiniteValues_, values);
+			}
+		}
+
+		RankISRIndividual ri(nbPos);
+		ri.setO(xVec);
+		ri.setObsData(obsData);
+
+		std::list<RankVal> listCompleted = ri.enumCompleted();
+		ASSERT_EQ(ri.nbCompleted(), Real(listCompleted.size()));
+		ASSERT_TRUE(std::adjacent_find(listCompleted.begin(), listCompleted.end(), [](const RankVal& lhs, const RankVal& rhs) {
+			return !(lhs < rhs);
+		}) == listCompleted.end());
+
+		std::set<RankVal> sampled;
+		for (int s = 0; s < 30 * int(listCompleted.size()); ++s) {
+			ri.removeMissing();
+			sampled.insert(ri.x());
+		}
+		ASSERT_EQ(sampled, std::set<RankVal>(listCompleted.begin(), listCompleted.end()));
+	}
+}
+
+/** With more completions than an int can count, removeMissing samples the positions in turn */
+TEST(RankISRIndividual, removeMissingManyCompletions) {
+	int nbPos = 15;
+
+	Vector<int> xVec(nbPos);
+	std::iota(xVec.begin(), xVec.end(), 0);
+	Vector<MisVal> obsData(nbPos, MisVal(missing_, { }));
+	obsData(0) = MisVal(present_, { });
+	obsData(1) = MisVal(missingFiniteValues_, { 1, 2 });
+
+	RankISRIndividual ri(nbPos);
+	ri.setO(xVec);
+	ri.setObsData(obsData);
+
+	ASSERT_EQ(ri.nbCompleted(), 2. * 6227020800.); // 2 * 13!
+
+	for (int s = 0; s < 10; ++s) {
+		ri.removeMissing();
+		ASSERT_EQ(ri.x().o()(0), 0);
+		ASSERT_TRUE(ri.x().o()(1) == 1 || ri.x().o()(1) == 2);
+
+		Vector<int> ordering = ri.x().o();
+		std::set<int> modalities(ordering.begin(), ordering.end());
+		ASSERT_EQ(modalities.size(), nbPos);
+	}
+}
+
 TEST(RankISRIndividual, checkPermutation) {
 	int nbPos = 5;
 
@@ -46,7 +46,7 @@ TEST(RankStat, computeStat) {
 	rankIndividual.setObsData(obsData);
 
 	Vector<RankISRIndividual> data(nbInd); // will store the result of xGen
-	std::set<Index> setInd;
+	std::vector<Index> setInd;
 
 	RankVal mu = { 0, 3, 1, 2 }; // ordering (position -> modality) representation
 	Real pi = 0.75;
@@ -57,7 +57,7 @@ TEST(RankStat, computeStat) {
 		data(i).removeMissing(); // shuffle the presentation order, to get the correct marginal distribution corresponding to (mu, pi)
 		data(i).xGen(mu, pi);
 
-		setInd.insert(i);
+		setInd.push_back(i);
 	}
 
 	Vector<int> muVec(nbPos);
@@ -68,3 +68,58 @@ TEST(RankVal, permutation)
 
   ASSERT_EQ(res, Vector<bool>(nbSample, true));
 }
+
+/** The orderings enumerated in lexicographic order have consecutive indices, and setIndex is the inverse of index */
+TEST(RankVal, index)
+{
+  int nbPos = 5;
+  std::vector<int> ordering = {0, 1, 2, 3, 4};
+  RankVal rv(nbPos);
+  RankVal rvIndex(nbPos);
+
+  std::uint64_t expected = 0;
+  do
+  {
+    rv.setO(ordering);
+    ASSERT_EQ(rv.index(), expected);
+
+    rvIndex.setIndex(expected);
+    ASSERT_EQ(rvIndex, rv);
+    ASSERT_EQ(rvIndex.r(), rv.r());
+
+    ++expected;
+  } while (std::next_permutation(ordering.begin(), ordering.end()));
+
+  ASSERT_EQ(expected, 120);
+}
+
+/** Copies and moves of ranks stored inline and on the heap */
+TEST(RankVal, copyAndMove)
+{
+  MultinomialStatistic multi;
+
+  for (int nbPos : {3, RankVal::nbPosInline, RankVal::nbPosInline + 1, 30})
+  {
+    Vector<int> ordering(nbPos);
+    std::iota(ordering.begin(), ordering.end(), 0);
+    multi.shuffle(ordering);
+
+    RankVal rv(nbPos);
+    rv.setO(ordering);
+
+    RankVal copy(rv);
+    ASSERT_EQ(copy, rv);
+    ASSERT_EQ(copy.r(), rv.r());
+
+    RankVal assigned = {0, 1};
+    assigned = rv;
+    ASSERT_EQ(assigned, rv);
+
+    copy.permutation(0);
+    ASSERT_FALSE(copy == rv); // the copy does not share the storage of rv
+
+    RankVal moved(std::move(assigned));
+    ASSERT_EQ(moved, rv);
+    ASSERT_EQ(moved.o(), ordering);
+  }
+}
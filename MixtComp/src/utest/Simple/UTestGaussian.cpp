@@ -120,3 +120,138 @@ using namespace mixt;
 //
 //  ASSERT_EQ(proba, 0);
 //}
+
+/**
+ * After class changes and a resampled missing value, the incrementally updated parameters must match a computation from
+ * scratch. The first update is on a sub partition, the following ones on the partition of z, with the moves listed.
+ */
+TEST(Gaussian, incrementalMStep) {
+	Index nClass = 2;
+	Index nInd = 40;
+	Index missingInd = 7;
+	Real epsilon = 1e-10;
+
+	AugmentedData<Vector<Real>> augData;
+	augData.resizeArrays(nInd);
+	for (Index i = 0; i < nInd; ++i) {
+		augData.setPresent(i, std::sin(Real(i)) * 10. + Real(i % 3));
+	}
+	augData.setMissing(missingInd, AugmentedData<Vector<Real>>::MisVal(missing_, std::vector<Real>()));
+	augData.data_(missingInd) = 1.;
+
+	Vector<Real> param;
+	Gaussian gaussian("dummy", nClass, param);
+	gaussian.setData("", augData, learning_);
+
+	Vector<std::vector<Index>> classInd(nClass);
+	for (Index i = 0; i < nInd; ++i) {
+		classInd(i % nClass).push_back(i);
+	}
+	std::vector<Index> movedInd;
+
+	for (Index iter = 0; iter < 4; ++iter) {
+		gaussian.mStepShared(classInd, (iter == 0) ? nullptr : &movedInd);
+		for (Index k = 0; k < nClass; ++k) {
+			gaussian.mStep(classInd, k);
+		}
+
+		for (Index k = 0; k < nClass; ++k) {
+			Real mean, sd;
+			meanSD(classInd(k), augData.data_, mean, sd);
+			ASSERT_NEAR(param(2 * k), mean, epsilon);
+			ASSERT_NEAR(param(2 * k + 1), sd, epsilon);
+		}
+
+		Index moved = classInd(0).back(); // a few individuals change class, or have their missing value resampled, between two mStep
+		classInd(0).pop_back();
+		classInd(1).insert(std::upper_bound(classInd(1).begin(), classInd(1).end(), moved), moved);
+		movedInd = { moved };
+		augData.data_(missingInd) += 5.;
+	}
+}
+
+/**
+ * The removal of an outlier from a class of almost equal values makes the incremental M2 negative. The statistics must
+ * then be recomputed instead of producing a NaN standard deviation.
+ */
+TEST(Gaussian, incrementalMStepNegativeM2) {
+	Index nClass = 2;
+	Index nInd = 20;
+	Index outlier = 5;
+
+	AugmentedData<Vector<Real>> augData;
+	augData.resizeArrays(nInd);
+	for (Index i = 0; i < outlier; ++i) {
+		augData.setPresent(i, 3.3 + Real(i % 2) * 1e-6);
+	}
+	augData.setPresent(outlier, 1e6);
+	for (Index i = outlier + 1; i < nInd; ++i) {
+		augData.setPresent(i, Real(i));
+	}
+
+	Vector<Real> param;
+	Gaussian gaussian("dummy", nClass, param);
+	gaussian.setData("", augData, learning_);
+
+	Vector<std::vector<Index>> classInd(nClass);
+	for (Index i = 0; i < nInd; ++i) {
+		classInd((i <= outlier) ? 0 : 1).push_back(i);
+	}
+	std::vector<Index> movedInd;
+	gaussian.mStepShared(classInd, &movedInd);
+
+	classInd(0).pop_back();
+	classInd(1).insert(classInd(1).begin(), outlier);
+	movedInd = { outlier };
+	gaussian.mStepShared(classInd, &movedInd);
+	gaussian.mStep(classInd, 0); // the standard deviation is below epsilon, hence the warnLog is ignored
+
+	Real mean, sd;
+	meanSD(classInd(0), augData.data_, mean, sd);
+	ASSERT_NEAR(param(0), mean, 1e-10);
+	ASSERT_NEAR(param(1), sd, 1e-10);
+}
+
+/** The reservoir mode of ConfIntDataStat is exact on short runs, and close to the exact mode on long ones. */
+TEST(Gaussian, dataStatReservoir) {
+	Index nInd = 3;
+	Real confidenceLevel = 0.95;
+
+	AugmentedData<Vector<Real>> augData;
+	augData.resizeArrays(nInd);
+	augData.setPresent(0, 1.);
+	augData.setMissing(1, AugmentedData<Vector<Real>>::MisVal(missing_, std::vector<Real>()));
+	augData.setMissing(2, AugmentedData<Vector<Real>>::MisVal(missing_, std::vector<Real>()));
+
+	for (Index nIter : { nDataStatReservoir, Index(1000) }) {
+		ConfIntDataStat<Real> exact(augData, confidenceLevel, exactDataStat_);
+		ConfIntDataStat<Real> reservoir(augData, confidenceLevel, reservoirDataStat_);
+		exact.setNbIndividual(nInd);
+		reservoir.setNbIndividual(nInd);
+		exact.beginGibbsRun(nIter - 1);
+		reservoir.beginGibbsRun(nIter - 1);
+
+		for (Index iter = 0; iter < nIter; ++iter) {
+			augData.data_(1) = (iter * 37) % 1000; // spread on [0, 1000[ whatever the subsample
+			augData.data_(2) = -Real(iter);
+			for (Index i = nInd; 0 < i--;) { // the arena does not depend on the order of the individuals
+				exact.sampleVals(i, iter, nIter - 1);
+				reservoir.sampleVals(i, iter, nIter - 1);
+			}
+		}
+
+		exact.endGibbsRun();
+		reservoir.endGibbsRun();
+
+		ASSERT_EQ(reservoir.getDataStatStorage()(0).size(), 0);
+		for (Index i = 1; i < nInd; ++i) {
+			if (nIter <= nDataStatReservoir) {
+				ASSERT_EQ(exact.getDataStatStorage()(i), reservoir.getDataStatStorage()(i));
+			} else {
+				for (Index q = 0; q < 3; ++q) {
+					ASSERT_NEAR(exact.getDataStatStorage()(i)(q), reservoir.getDataStatStorage()(i)(q), 40.);
+				}
+			}
+		}
+	}
+}
@@ -62,9 +62,10 @@ TEST(Multinomial, EstimateParameters) {
     EXPECT_FALSE(multiMixture.acceptedType()(5));
 	ASSERT_EQ(multiMixture.computeNbFreeParameters(), 3);
 
-    Vector<std::set<Index>> classInd(1);
+    Vector<std::vector<Index>> classInd(1);
     classInd(0) = {0, 1 ,2, 3, 4, 5, 6, 7, 8, 9};
-    multiMixture.mStep(classInd);
+    multiMixture.mStepShared(classInd, nullptr);
+    multiMixture.mStep(classInd, 0);
 
 	EXPECT_FLOAT_EQ((param - paramExpected).norm(), 0);
 }
@@ -49,7 +49,7 @@ TEST(NegativeBinomial, EstimateK) {
 	Real nComputed = nb.estimateN(x, 10.0);
 	Real pComputed = nb.estimateP(x, nExpected);
 
-	ASSERT_NEAR(nExpected, nComputed, 0.1);
+	ASSERT_NEAR(nExpected, nComputed, 1.0); // standard error of the estimator of n is around 0.3 with 100000 observations
 	ASSERT_NEAR(pExpected, pComputed, 0.01);
 }
 
@@ -65,7 +65,7 @@ TEST(NegativeBinomial, SampleAndEstimate) {
 	Index nClass = 1;
 
 	std::string idName = "dummy";
-	Vector<std::set<Index>> classInd;
+	Vector<std::vector<Index>> classInd;
 
 	AugmentedData<Vector<int>> augData;
 	augData.setAllMissing(nObs);
@@ -75,9 +75,9 @@ TEST(NegativeBinomial, SampleAndEstimate) {
 
 	Vector<Real> paramExpected = param;
 
-	Vector<std::set<Index>> setInd(nClass);
+	Vector<std::vector<Index>> setInd(nClass);
 	for (Index i = 0; i < nObs; ++i) {
-		setInd(0).insert(i);
+		setInd(0).push_back(i);
 	}
 
 	NegativeBinomialSampler nbsampler(augData, param, 1);
@@ -88,7 +88,7 @@ TEST(NegativeBinomial, SampleAndEstimate) {
 	NegativeBinomial nbinom(idName, nClass, param);
 	nbinom.setData("", augData, learning_);
 	nbinom.initParam();
-	nbinom.mStep(setInd);
+	nbinom.mStep(setInd, 0);
 
 	ASSERT_NEAR(nExpected, param(0), 0.1);
 	ASSERT_NEAR(pExpected, param(1), 0.01);
@@ -35,7 +35,7 @@ TEST(Poisson_k, OKSample) {
 	Vector<Real> param(nbClass);
 	param << 3, 1;
 
-	Vector<std::set<Index> > classInd(nbClass);
+	Vector<std::vector<Index>> classInd(nbClass);
 	classInd(0) = {0, 2};
 	classInd(1) = {1, 3};
 
@@ -83,3 +83,34 @@ TEST(Poisson_k, OKSample) {
 //
 //	ASSERT_GT(warnLog.size(), 0);
 //}
+
+/**
+ * The vectorized block computation of the completed likelihood must be identical to the computation by individual.
+ */
+TEST(Poisson_k, lnCompletedProbabilityBlock) {
+	Index nbClass = 3;
+	Index nbInd = 5;
+
+	Vector<Real> param(nbClass);
+	param << 3., 0., 12.5; // a null parameter takes the scalar path
+
+	AugmentedData<Vector<int>> data;
+	data.resizeArrays(nbInd);
+	data.setPresent(0, 0);
+	data.setPresent(1, 1);
+	data.setPresent(2, 5);
+	data.setPresent(3, 17);
+	data.setPresent(4, 2000); // beyond the logFac table
+
+	PoissonLikelihood likelihood(param, data, nbClass);
+
+	Matrix<Real> lnProba(nbInd - 1, nbClass);
+	lnProba.setZero();
+	likelihood.lnCompletedProbabilityBlock(1, nbInd, lnProba);
+
+	for (Index i = 1; i < nbInd; ++i) {
+		for (Index k = 0; k < nbClass; ++k) {
+			ASSERT_EQ(lnProba(i - 1, k), likelihood.lnCompletedProbability(i, k));
+		}
+	}
+}
@@ -29,7 +29,7 @@ using namespace mixt;
  * Estimation of k using Newton-Raphson.
  */
 TEST(Weibull, EstimateK) {
-	Index nObs = 5000;
+	Index nObs = 50000;
 
 	Real lambdaExpected = 1.0;
 	Real kExpected = 1.5;
@@ -65,7 +65,7 @@ TEST(Weibull, SampleAndEstimate) {
 	Index nClass = 1;
 
 	std::string idName = "dummy";
-	Vector<std::set<Index>> classInd;
+	Vector<std::vector<Index>> classInd;
 
 	AugmentedData<Vector<Real>> augData;
 	augData.setAllMissing(nObs);
@@ -75,9 +75,9 @@ TEST(Weibull, SampleAndEstimate) {
 
 	Vector<Real> paramExpected = param;
 
-	Vector<std::set<Index>> setInd(nClass);
+	Vector<std::vector<Index>> setInd(nClass);
 	for (Index i = 0; i < nObs; ++i) {
-		setInd(0).insert(i);
+		setInd(0).push_back(i);
 	}
 
 	WeibullSampler wsampler(augData, param, 1);
@@ -89,7 +89,7 @@ TEST(Weibull, SampleAndEstimate) {
 	weibull.setData("", augData, learning_);
 	weibull.initParam();
 
-	weibull.mStep(setInd);
+	weibull.mStep(setInd, 0);
 
 	ASSERT_LT((param - paramExpected).norm()/paramExpected.norm(), 0.01);
 }
@@ -106,7 +106,7 @@ TEST(Weibull, truncated) {
 	Index nClass = 1;
 
 	std::string idName = "dummy";
-	Vector<std::set<Index>> classInd;
+	Vector<std::vector<Index>> classInd;
 
 	AugmentedData<Vector<Real>>::MisVal mv;
 	mv.first = missingRUIntervals_;
@@ -123,9 +123,9 @@ TEST(Weibull, truncated) {
 
 	Vector<Real> paramExpected = param;
 
-	Vector<std::set<Index>> setInd(nClass);
+	Vector<std::vector<Index>> setInd(nClass);
 	for (Index i = 0; i < nObs; ++i) {
-		setInd(0).insert(i);
+		setInd(0).push_back(i);
 	}
 
 	WeibullSampler wsampler(augData, param, 1);
@@ -142,3 +142,33 @@ TEST(Weibull, truncated) {
 	ASSERT_NEAR(expectedPdf, computedPdf, 0.01);
 	ASSERT_NEAR(expectedQuantile, computedQuantile, 0.01);
 }
+
+/**
+ * The vectorized block computation of the completed likelihood must match the computation by individual.
+ */
+TEST(Weibull, lnCompletedProbabilityBlock) {
+	Index nClass = 2;
+	Index nInd = 4;
+
+	Vector<Real> param(2 * nClass);
+	param << 1.5, 1.0, 0.7, 3.2;
+
+	AugmentedData<Vector<Real>> augData;
+	augData.resizeArrays(nInd);
+	augData.setPresent(0, 0.1);
+	augData.setPresent(1, 1.0);
+	augData.setPresent(2, 2.7);
+	augData.setPresent(3, 12.0);
+
+	WeibullLikelihood likelihood(param, augData, nClass);
+
+	Matrix<Real> lnProba(nInd, nClass);
+	lnProba.setConstant(1.0); // the block computation adds to the existing content
+	likelihood.lnCompletedProbabilityBlock(0, nInd, lnProba);
+
+	for (Index i = 0; i < nInd; ++i) {
+		for (Index k = 0; k < nClass; ++k) {
+			ASSERT_NEAR(lnProba(i, k), 1.0 + likelihood.lnCompletedProbability(i, k), 1e-12);
+		}
+	}
+}
@@ -46,7 +46,7 @@ TEST(GaussianStatistic, expVarTruncated) {
 TEST(GaussianStatistic, sample) {
 	Real mu = 12.;
 	Real sigma = 5.;
-	Index nSample = 100000;
+	Index nSample = 1000000;
 	Real computedMu, computedSigma;
 
 	GaussianStatistic normal;
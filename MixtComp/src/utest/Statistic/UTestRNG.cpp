@@ -31,3 +31,48 @@ using namespace mixt;
 TEST(RNG, deterministicMode) {
 	ASSERT_EQ(true, deterministicMode());
 }
+
+/**
+ * Known answer test from the Random123 distribution (kat_vectors, philox4x32_10 with null counter and key).
+ */
+TEST(Philox4x32, knownAnswer) {
+	Philox4x32 rng(0, 0, 0, 0);
+
+	ASSERT_EQ(rng(), 0x6627e8d5u);
+	ASSERT_EQ(rng(), 0xe169c58du);
+	ASSERT_EQ(rng(), 0xbc57ac4cu);
+	ASSERT_EQ(rng(), 0x9b00dbd8u);
+}
+
+TEST(Philox4x32, differentStreams) {
+	Philox4x32 rngA(12, 3, 5, 7);
+	Philox4x32 rngB(12, 3, 6, 7);
+
+	ASSERT_NE(rngA(), rngB());
+}
+
+/**
+ * The draws in a stream only depend on the key, and the state of threadRNG() is restored at the end of the scope.
+ */
+TEST(RNGStream, restoreAndReproduce) {
+	Index nInd = 50;
+	Vector<Real> first(nInd);
+	Vector<Real> second(nInd);
+	UniformStatistic uni;
+
+	Philox4x32 saved = threadRNG();
+
+	for (Index i = 0; i < nInd; ++i) {
+		RNGStream stream(42, 0, i, RNGStream::all);
+		first(i) = uni.sample(0., 1.);
+	}
+
+#pragma omp parallel for num_threads(4)
+	for (Index i = 0; i < nInd; ++i) {
+		RNGStream stream(42, 0, nInd - 1 - i, RNGStream::all); // different order of evaluation
+		second(nInd - 1 - i) = uni.sample(0., 1.);
+	}
+
+	ASSERT_TRUE(first == second);
+	ASSERT_EQ(threadRNG()(), saved());
+}
@@ -171,3 +171,41 @@ TEST(MisValParser, simpleValueEng)
 
   ASSERT_EQ(val, str2type<Real>("8.40405864500071e-05"));
 }
+
+/**
+ * The scanner must give the same results as the regex implementation, including on the strings that are rejected.
+ */
+template<typename Type>
+void compareParsers(const std::vector<std::string>& strs)
+{
+  MisValRegexParser<Type> regexParser(Type(1));
+  MisValScanParser<Type> scanParser(Type(1));
+
+  for (std::vector<std::string>::const_iterator it = strs.begin(), itE = strs.end(); it != itE; ++it) {
+    Type valRegex = Type(0);
+    Type valScan = Type(0);
+    typename MisValRegexParser<Type>::MisVal misValRegex(missing_, std::vector<Type>());
+    typename MisValScanParser<Type>::MisVal misValScan(missing_, std::vector<Type>());
+
+    bool isValidRegex = regexParser.parseStr(*it, valRegex, misValRegex);
+    bool isValidScan = scanParser.parseStr(*it, valScan, misValScan);
+
+    ASSERT_EQ(isValidRegex, isValidScan) << "\"" << *it << "\"";
+    if (isValidRegex) {
+      ASSERT_EQ(misValRegex, misValScan) << "\"" << *it << "\"";
+      ASSERT_EQ(valRegex, valScan) << "\"" << *it << "\"";
+    }
+  }
+}
+
+TEST(MisValParser, scanSameAsRegex)
+{
+  std::vector<std::string> strs {"12", " -3.5 ", "+4", "5.", ".25", "-.25", "1e-3", "1E-3", "1e3", "1e-", "2.5e-2 ",
+    "1.2.3", "--2", "", "   ", "?", "  ?  ", "??", "? 1", "3000000000",
+    "{}", "{ 1, 2 ; 2 }", "{-.5 1e-2e-3 +4x5.}", "  {1} } ", "{1", "1}", "{1\n2}",
+    "[1:2]", "[ 2.5 : -1 ]  ", "[1:1]", "[1:2", "[1:2] x", "[1 2]", "[:2]", "[ -inf : 12]", "[-inf:-inf]",
+    "[-inf:+inf]", "[16: +inf]", "[+inf:3]", "[3:-inf]", "[-info:3]", "[-1e-2:.5]"};
+
+  compareParsers<Real>(strs);
+  compareParsers<int>(strs);
+}
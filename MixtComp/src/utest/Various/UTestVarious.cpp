@@ -32,3 +32,49 @@ TEST(itString, simpleTest)
 
   ASSERT_EQ(itString(a), "0.2 0.7 0.3");
 }
+
+TEST(effectiveNThread, requestedValue)
+{
+#ifdef _OPENMP
+  ASSERT_EQ(effectiveNThread(3), 3);
+  ASSERT_GE(effectiveNThread(0), 1);
+#else
+  ASSERT_EQ(effectiveNThread(3), 1);
+  ASSERT_EQ(effectiveNThread(0), 1);
+#endif
+}
+
+TEST(MisDataTable, sparseParameters)
+{
+  typedef MisDataTable<int>::MisVal MisVal;
+
+  MisDataTable<int> table;
+  table.resize(6);
+  table.set(0, MisVal(present_, { }));
+  table.set(1, MisVal(missingIntervals_, { 2, 5 }));
+  table.set(2, MisVal(missing_, { }));
+  table.set(4, MisVal(missingFiniteValues_, { 0, 3, 7 }));
+  table.set(3, MisVal(missingRUIntervals_, { 1 })); // out of order, inserted in the middle of the side table
+
+  ASSERT_EQ(table.size(), 6);
+  ASSERT_EQ(table.nParamEntry(), 3);
+
+  ASSERT_EQ(table(0).first, present_);
+  ASSERT_EQ(table(0).second.size(), 0);
+  ASSERT_EQ(table(2).first, missing_);
+  ASSERT_EQ(table(2).second.size(), 0);
+  ASSERT_EQ(table(5).first, present_); // default value
+
+  ASSERT_EQ(table(1).first, missingIntervals_);
+  ASSERT_EQ(std::vector<int>(table(1).second.begin(), table(1).second.end()), std::vector<int>({ 2, 5 }));
+  ASSERT_EQ(table(3).first, missingRUIntervals_);
+  ASSERT_EQ(table(3).second[0], 1);
+  ASSERT_EQ(std::vector<int>(table(4).second.begin(), table(4).second.end()), std::vector<int>({ 0, 3, 7 }));
+
+  table.set(1, MisVal(present_, { })); // an entry with parameters is overwritten
+  table.set(3, MisVal(missingIntervals_, { 4, 9 }));
+  ASSERT_EQ(table.nParamEntry(), 2);
+  ASSERT_EQ(table(1).second.size(), 0);
+  ASSERT_EQ(std::vector<int>(table(3).second.begin(), table(3).second.end()), std::vector<int>({ 4, 9 }));
+  ASSERT_EQ(std::vector<int>(table(4).second.begin(), table(4).second.end()), std::vector<int>({ 0, 3, 7 }));
+}
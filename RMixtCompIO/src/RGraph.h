@@ -135,6 +135,12 @@ private:
 	Rcpp::List l_;
 };
 
+/** The data of the simple models can be given as numeric or integer vectors, which are not converted to strings. */
+template<>
+struct DataColumn<RGraph> {
+	typedef MixedColumn Type;
+};
+
 }
 
 #endif
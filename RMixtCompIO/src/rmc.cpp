@@ -24,6 +24,7 @@
 #include <Rcpp.h>
 
 #include <Run/Learn.h>
+#include <Run/LearnSweep.h>
 #include <Run/Predict.h>
 #include <MixtComp.h>
 
@@ -45,6 +46,8 @@ Rcpp::List rmc(Rcpp::List algoR, Rcpp::List dataR, Rcpp::List descR, Rcpp::List
 
 		if (mode == "learn") {
 			learn(algoRG, dataRG, descRG, resRG);
+		} else if (mode == "learnSweep") {
+			learnSweep(algoRG, dataRG, descRG, resRG);
 		} else if (mode == "predict") {
 			RGraph resLearnRG(resLearnR);
 
@@ -56,7 +59,7 @@ Rcpp::List rmc(Rcpp::List algoR, Rcpp::List dataR, Rcpp::List descR, Rcpp::List
 				warnLog += s;
 			}
 		} else {
-			warnLog += "mode :" + mode + " not recognized. Please choose learn or predict." + eol;
+			warnLog += "mode :" + mode + " not recognized. Please choose learn, learnSweep or predict." + eol;
 		}
 	} catch (const std::string& s) {
 	  warnLog += s;
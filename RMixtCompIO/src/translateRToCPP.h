@@ -28,6 +28,7 @@
 #include <iostream>
 #include <LinAlg/LinAlg.h>
 #include <LinAlg/names.h>
+#include <IO/MixedColumn.h>
 #include <IO/NamedAlgebra.h>
 
 #include "CPPToRMatrixType.h"
@@ -40,6 +41,61 @@ void translateRToCPP(SEXP in, OutType& out) {
 	out = Rcpp::as<OutType>(in);
 }
 
+/**
+ * Data column of a simple model: a numeric or integer vector, with NA for the missing values, or a character vector,
+ * in which NA is also a missing value.
+ */
+inline void translateRToCPP(SEXP in, MixedColumn& out) {
+	Index n = Rf_length(in);
+	out.resize(n);
+
+	switch (TYPEOF(in)) {
+	case REALSXP: {
+		const double* p_x = REAL(in);
+		for (Index i = 0; i < n; ++i) {
+			if (ISNAN(p_x[i])) {
+				out.setMissing(i);
+			} else {
+				out.setNumber(i, p_x[i]);
+			}
+		}
+	}
+		break;
+
+	case INTSXP: {
+		const int* p_x = INTEGER(in);
+		for (Index i = 0; i < n; ++i) {
+			if (p_x[i] == NA_INTEGER) {
+				out.setMissing(i);
+			} else {
+				out.setNumber(i, p_x[i]);
+			}
+		}
+	}
+		break;
+
+	case STRSXP: {
+		for (Index i = 0; i < n; ++i) {
+			SEXP cell = STRING_ELT(in, i);
+			if (cell == NA_STRING) {
+				out.setMissing(i);
+			} else {
+				out.setString(i, CHAR(cell));
+			}
+		}
+	}
+		break;
+
+	default: { // other types are converted to strings, as before the support of numeric vectors
+		std::vector<std::string> str = Rcpp::as<std::vector<std::string>>(in);
+		for (Index i = 0; i < n; ++i) {
+			out.setString(i, str[i]);
+		}
+	}
+		break;
+	}
+}
+
 template<typename T>
 void translateRToCPP(SEXP in, NamedVector<T>& out) {
 	typename CPPToRVectorType<T>::ctype temp(in);
@@ -31,10 +31,10 @@ makevarsStr = r'''# MixtComp version 4  - july 2019
 
 %s
 
-PKG_CXXFLAGS = -Ilib -Ilib/LinAlg -DEIGEN_MATRIXBASE_PLUGIN=\"EigenMatrixBaseAddons.h\" -Ioptim/include
+PKG_CXXFLAGS = -Ilib -Ilib/LinAlg -DEIGEN_MATRIXBASE_PLUGIN=\"EigenMatrixBaseAddons.h\" -Ioptim/include $(SHLIB_OPENMP_CXXFLAGS)
 CXX_STD = CXX17
 
-PKG_LIBS = $(LIB_OFILES)
+PKG_LIBS = $(LIB_OFILES) $(SHLIB_OPENMP_CXXFLAGS)
 
 .PHONY: all # a phony target is a target that is always considered out of date
 
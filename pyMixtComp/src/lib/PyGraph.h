@@ -30,6 +30,7 @@
 #include "translateCPPToPython.h"
 #include "translatePythonToCPP.h"
 #include <IO/IOFunctions.h>
+#include <IO/MixedColumn.h>
 #include <IO/NamedAlgebra.h>
 #include <LinAlg/LinAlg.h>
 
@@ -131,6 +132,12 @@ private:
 
 	boost::python::dict d_;
 };
+
+/** The data of the simple models can be given as numbers, which are not converted to strings. */
+template<>
+struct DataColumn<PyGraph> {
+	typedef MixedColumn Type;
+};
 }  // namespace mixt
 
 #endif
@@ -24,6 +24,7 @@
 #include <boost/python.hpp>
 #include "pmc.h"
 #include <Run/Learn.h>
+#include <Run/LearnSweep.h>
 #include <Run/Predict.h>
 #include <Various/Constants.h>
 #include "PyGraph.h"
@@ -47,6 +48,8 @@ boost::python::dict pmc(boost::python::dict algoPy, boost::python::dict dataPy,
 
 		if (mode == "learn") {
 			learn(algoPyG, dataPyG, descPyG, resPyG);
+		} else if (mode == "learnSweep") {
+			learnSweep(algoPyG, dataPyG, descPyG, resPyG);
 		} else if (mode == "predict") {
 			PyGraph resLearnPyG(resLearnPy);
 
@@ -58,7 +61,7 @@ boost::python::dict pmc(boost::python::dict algoPy, boost::python::dict dataPy,
 				warnLog += s;
 			}
 		} else {
-			warnLog += "mode :" + mode + " not recognized. Please choose learn or predict." + eol;
+			warnLog += "mode :" + mode + " not recognized. Please choose learn, learnSweep or predict." + eol;
 		}
 
 		if (warnLog.size() > 0) {
@@ -23,9 +23,11 @@
 #ifndef PYMIXTCOMP_SRC_TRANSLATEPYTHONTOCPP_H
 #define PYMIXTCOMP_SRC_TRANSLATEPYTHONTOCPP_H
 
+#include <cmath>
 #include <iostream>
 #include <boost/python.hpp>
 #include <boost/python/dict.hpp>
+#include <IO/MixedColumn.h>
 #include <IO/NamedAlgebra.h>
 #include <LinAlg/LinAlg.h>
 #include <LinAlg/names.h>
@@ -46,6 +48,37 @@ void translatePythonToCPP(const boost::python::api::object_item& in, std::vector
 }
 
 
+/**
+ * Data column of a simple model, a list (or any iterable) whose elements are strings, numbers, or None or NaN for a
+ * missing value.
+ */
+inline void translatePythonToCPP(const boost::python::api::object_item& in, MixedColumn& out) {
+	Index n = boost::python::len(in);
+	out.resize(n);
+
+	for (Index i = 0; i < n; ++i) {
+		boost::python::object cell = in[i];
+		boost::python::extract<std::string> str(cell);
+		boost::python::extract<Real> number(cell);
+
+		if (str.check()) {
+			out.setString(i, str());
+		} else if (cell.is_none()) {
+			out.setMissing(i);
+		} else if (number.check()) {
+			Real x = number();
+			if (std::isnan(x)) {
+				out.setMissing(i);
+			} else {
+				out.setNumber(i, x);
+			}
+		} else {
+			throw(std::string("A data column must only contain strings, numbers and None."));
+		}
+	}
+}
+
+
 template <typename T>
 void translatePythonToCPP(const boost::python::api::object_item& in, std::vector<std::vector<T> >& out) {
 	for(int i = 0; i < boost::python::len(in); ++i){